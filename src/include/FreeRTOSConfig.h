@@ -75,13 +75,14 @@
  #define configAPPLICATION_ALLOCATED_HEAP        0
  
  /* Hook function related definitions. */
- #define configCHECK_FOR_STACK_OVERFLOW          0
+ #define configCHECK_FOR_STACK_OVERFLOW          2   /* vApplicationStackOverflowHook em main.c */
  #define configUSE_MALLOC_FAILED_HOOK            0
  #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
  
  /* Run time and task stats gathering related definitions. */
  #define configGENERATE_RUN_TIME_STATS           0
  #define configUSE_TRACE_FACILITY                1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2   /* Índice 1: barramento de estado (state_bus.h) */
  #define configUSE_STATS_FORMATTING_FUNCTIONS    0
  
  /* Co-routine related definitions. */
@@ -102,7 +103,17 @@
  */
  
  /* SMP port only */
+ /* FLOOD_DUAL_CORE (opção do CMake) escolhe entre o build SMP e o de um núcleo,
+  * para comparar jitter de amostragem e latência fim a fim entre os dois. */
+ #ifndef FLOOD_DUAL_CORE
+ #define FLOOD_DUAL_CORE                         1
+ #endif
+ #if FLOOD_DUAL_CORE
+ #define configNUM_CORES                         2
+ #define configUSE_CORE_AFFINITY                 1   /* Aquisição no núcleo 0, saídas no núcleo 1 (config.h) */
+ #else
  #define configNUM_CORES                         1
+ #endif
  #define configTICK_CORE                         1
  #define configRUN_MULTIPLE_PRIORITIES           1
  
@@ -134,5 +145,17 @@
  #define INCLUDE_xQueueGetMutexHolder            1
  
  /* A header file that defines trace macro can be included here. */
+ /* Contador de trocas de contexto usado para comparar tamanhos de lote (SENSOR_BLOCK_LEN).
+  * Um contador por núcleo: no SMP os dois núcleos trocam de contexto ao mesmo tempo
+  * e cada um só incrementa o seu, sem corrida no read-modify-write. */
+ #ifndef __ASSEMBLER__
+ #include <stdint.h>
+ extern volatile uint32_t ulContextSwitchCount[ configNUM_CORES ];
+ #endif
+ #if ( configNUM_CORES > 1 )
+ #define traceTASK_SWITCHED_IN()                 ( ulContextSwitchCount[ portGET_CORE_ID() ]++ )
+ #else
+ #define traceTASK_SWITCHED_IN()                 ( ulContextSwitchCount[ 0 ]++ )
+ #endif
  
  #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
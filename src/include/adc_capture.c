@@ -0,0 +1,146 @@
+#include "adc_capture.h"
+#include "sample_ring.h"
+#include "config.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// --- Internal Definitions ---
+// Dois canais DMA encadeados entre si: enquanto um preenche seu bloco, o outro
+// já está armado para o bloco seguinte, de modo que o ADC nunca para.
+static uint16_t capture_storage[SAMPLE_RING_BLOCKS][ADC_CAPTURE_BLOCK_SAMPLES * ADC_CAPTURE_CHANNEL_COUNT];
+static sample_ring_t capture_ring;
+static int capture_dma_chan[SAMPLE_RING_BLOCKS];
+static TaskHandle_t capture_notify_task = NULL;
+static volatile uint32_t capture_block_time_us[SAMPLE_RING_BLOCKS]; // Instante em que cada bloco ficou cheio
+
+/**
+ * @brief Handler compartilhado do DMA_IRQ_0. Para cada canal de captura concluído,
+ *        entrega o bloco ao anel, rearma o endereço de escrita do canal e notifica a tarefa.
+ */
+static void adc_capture_dma_irq_handler(void) {
+    BaseType_t higher_priority_woken = pdFALSE;
+
+    for (uint8_t i = 0; i < SAMPLE_RING_BLOCKS; ++i) {
+        uint chan = (uint)capture_dma_chan[i];
+        if (!dma_channel_get_irq0_status(chan)) {
+            continue;
+        }
+        dma_channel_acknowledge_irq0(chan);
+
+        uint8_t completed = sample_ring_commit(&capture_ring);
+        capture_block_time_us[completed] = time_us_32();
+        // O contador de transferências é recarregado automaticamente no próximo disparo;
+        // apenas o endereço de escrita precisa voltar ao início do bloco.
+        dma_channel_set_write_addr(chan, sample_ring_block(&capture_ring, completed), false);
+
+        if (capture_notify_task != NULL) {
+            vTaskNotifyGiveFromISR(capture_notify_task, &higher_priority_woken);
+        }
+    }
+
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+// Obtém um bloco com a IRQ do DMA bloqueada: o descarte do bloco em reescrita
+// (sample_ring_acquire) não pode se intercalar com um commit da ISR
+static const uint16_t *adc_capture_acquire(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    const uint16_t *block = sample_ring_acquire(&capture_ring);
+    restore_interrupts(irq_state);
+    return block;
+}
+
+// --- Public API Functions ---
+
+/**
+ * @brief Configura o ADC em round-robin sobre os canais de água e chuva e os dois
+ *        canais DMA que escrevem no anel duplo. Deve ser chamada após joystick_init().
+ */
+void adc_capture_init(void) {
+    sample_ring_init(&capture_ring, &capture_storage[0][0], ADC_CAPTURE_BLOCK_SAMPLES, ADC_CAPTURE_CHANNEL_COUNT);
+
+    adc_select_input(JOYSTICK_ADC_X_CHAN); // O round-robin começa pelo canal de água
+    adc_set_round_robin((1u << JOYSTICK_ADC_X_CHAN) | (1u << JOYSTICK_ADC_Y_CHAN));
+    // FIFO habilitado, DREQ a cada amostra, sem bit de erro e sem deslocamento para 8 bits
+    adc_fifo_setup(true, true, 1, false, false);
+    // Período de conversão = (1 + div) ciclos do clock de 48 MHz do ADC
+    adc_set_clkdiv((float)ADC_CAPTURE_CLOCK_HZ / (ADC_CAPTURE_SAMPLE_RATE_HZ * ADC_CAPTURE_CHANNEL_COUNT) - 1.0f);
+
+    for (uint8_t i = 0; i < SAMPLE_RING_BLOCKS; ++i) {
+        capture_dma_chan[i] = dma_claim_unused_channel(true);
+    }
+
+    for (uint8_t i = 0; i < SAMPLE_RING_BLOCKS; ++i) {
+        uint chan = (uint)capture_dma_chan[i];
+        dma_channel_config cfg = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+        channel_config_set_read_increment(&cfg, false);
+        channel_config_set_write_increment(&cfg, true);
+        channel_config_set_dreq(&cfg, DREQ_ADC);
+        channel_config_set_chain_to(&cfg, (uint)capture_dma_chan[(i + 1) % SAMPLE_RING_BLOCKS]);
+        dma_channel_configure(
+            chan,
+            &cfg,
+            sample_ring_block(&capture_ring, i),
+            &adc_hw->fifo,
+            sample_ring_block_words(&capture_ring),
+            false
+        );
+        dma_channel_set_irq0_enabled(chan, true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, adc_capture_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    printf("ADC capture: %d Hz/canal, bloco de %d amostras (DMA %d/%d)\n",
+        ADC_CAPTURE_SAMPLE_RATE_HZ, ADC_CAPTURE_BLOCK_SAMPLES, capture_dma_chan[0], capture_dma_chan[1]);
+}
+
+/**
+ * @brief Inicia a conversão contínua. A tarefa indicada é notificada a cada bloco cheio.
+ *
+ * @param notify_task Tarefa que consome os blocos (normalmente a própria chamadora).
+ */
+void adc_capture_start(TaskHandle_t notify_task) {
+    capture_notify_task = notify_task;
+    adc_fifo_drain();
+    dma_channel_start((uint)capture_dma_chan[0]);
+    adc_run(true);
+}
+
+/**
+ * @brief Bloqueia a tarefa até haver um bloco cheio, sem consumir CPU durante a espera.
+ *
+ * @param timeout Tempo máximo de espera em ticks.
+ * @return Amostras intercaladas (água, chuva, água, ...) ou NULL em caso de timeout.
+ *         O bloco deve ser devolvido com adc_capture_release_block().
+ */
+const uint16_t *adc_capture_wait_block(TickType_t timeout) {
+    const uint16_t *block = adc_capture_acquire();
+    if (block == NULL) {
+        ulTaskNotifyTake(pdTRUE, timeout);
+        block = adc_capture_acquire();
+    }
+    return block;
+}
+
+/**
+ * @brief Instante (time_us_32) em que o bloco atualmente obtido ficou cheio,
+ *        ou seja, o instante aproximado da última amostra do bloco.
+ */
+uint32_t adc_capture_block_timestamp_us(void) {
+    return capture_block_time_us[capture_ring.read_block];
+}
+
+void adc_capture_release_block(void) {
+    sample_ring_release(&capture_ring);
+}
+
+/**
+ * @brief Número de blocos sobrescritos pelo DMA antes de a tarefa liberá-los.
+ */
+uint32_t adc_capture_overruns(void) {
+    return capture_ring.overruns;
+}
@@ -0,0 +1,16 @@
+#ifndef ADC_CAPTURE_H
+#define ADC_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+void adc_capture_init(void);
+void adc_capture_start(TaskHandle_t notify_task);
+const uint16_t *adc_capture_wait_block(TickType_t timeout);
+uint32_t adc_capture_block_timestamp_us(void);
+void adc_capture_release_block(void);
+uint32_t adc_capture_overruns(void);
+
+#endif // ADC_CAPTURE_H
@@ -0,0 +1,129 @@
+#include "alert_rules.h"
+
+// --- Geração da tabela em tempo de compilação ---
+
+#define ALERT_TIER_MASK ((1u << ALERT_TIER_BITS) - 1)
+
+// Severidade do sensor `s` codificada na chave `key`
+#define ALERT_KEY_TIER(key, s) (((uint32_t)(key) >> (ALERT_TIER_BITS * (s))) & ALERT_TIER_MASK)
+
+// A chave atende aos requisitos `req` quando cada sensor atinge a severidade exigida
+#define ALERT_TIER_GE_REQ(name, thresholds, key, req) \
+    && (ALERT_KEY_TIER(key, ALERT_SENSOR_##name) >= ALERT_KEY_TIER(req, ALERT_SENSOR_##name))
+#define ALERT_RULE_MATCHES(key, req) (1 ALERT_SENSOR_TABLE(ALERT_TIER_GE_REQ, key, req))
+
+// Primeira regra que casa (em ordem de prioridade) define o nível e a severidade mínima
+#define ALERT_RULE_LEVEL_STEP(level, severity, req, key)    ALERT_RULE_MATCHES(key, req) ? (level) :
+#define ALERT_RULE_SEVERITY_STEP(level, severity, req, key) ALERT_RULE_MATCHES(key, req) ? (severity) :
+#define ALERT_RULE_LEVEL(key)    (ALERT_RULE_TABLE(ALERT_RULE_LEVEL_STEP, key) ALERT_NONE)
+#define ALERT_RULE_SEVERITY(key) (ALERT_RULE_TABLE(ALERT_RULE_SEVERITY_STEP, key) ALERT_SEVERITY_NONE)
+
+// Maior severidade individual: soma de "algum sensor atingiu o nível t" para t = 1..7
+// (níveis acima de ALERT_SEVERITY_LEVELS - 1 nunca aparecem na chave e somam zero)
+#define ALERT_TIER_AT_LEAST(name, thresholds, key, tier) \
+    || (ALERT_KEY_TIER(key, ALERT_SENSOR_##name) >= (tier))
+#define ALERT_ANY_TIER(key, tier) (0 ALERT_SENSOR_TABLE(ALERT_TIER_AT_LEAST, key, tier))
+#define ALERT_MAX_TIER(key) \
+    (ALERT_ANY_TIER(key, 1) + ALERT_ANY_TIER(key, 2) + ALERT_ANY_TIER(key, 3) + ALERT_ANY_TIER(key, 4) + \
+     ALERT_ANY_TIER(key, 5) + ALERT_ANY_TIER(key, 6) + ALERT_ANY_TIER(key, 7))
+
+#define ALERT_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define ALERT_LUT_ENTRY(key) { ALERT_RULE_LEVEL(key), ALERT_MAX(ALERT_MAX_TIER(key), ALERT_RULE_SEVERITY(key)) },
+
+// Repetição em potências de 2, escolhida pelo número de bits da chave
+#define ALERT_REPEAT_B0(F, base)  F(base)
+#define ALERT_REPEAT_B1(F, base)  ALERT_REPEAT_B0(F, base) ALERT_REPEAT_B0(F, (base) + 0x001)
+#define ALERT_REPEAT_B2(F, base)  ALERT_REPEAT_B1(F, base) ALERT_REPEAT_B1(F, (base) + 0x002)
+#define ALERT_REPEAT_B3(F, base)  ALERT_REPEAT_B2(F, base) ALERT_REPEAT_B2(F, (base) + 0x004)
+#define ALERT_REPEAT_B4(F, base)  ALERT_REPEAT_B3(F, base) ALERT_REPEAT_B3(F, (base) + 0x008)
+#define ALERT_REPEAT_B5(F, base)  ALERT_REPEAT_B4(F, base) ALERT_REPEAT_B4(F, (base) + 0x010)
+#define ALERT_REPEAT_B6(F, base)  ALERT_REPEAT_B5(F, base) ALERT_REPEAT_B5(F, (base) + 0x020)
+#define ALERT_REPEAT_B7(F, base)  ALERT_REPEAT_B6(F, base) ALERT_REPEAT_B6(F, (base) + 0x040)
+#define ALERT_REPEAT_B8(F, base)  ALERT_REPEAT_B7(F, base) ALERT_REPEAT_B7(F, (base) + 0x080)
+#define ALERT_REPEAT_B9(F, base)  ALERT_REPEAT_B8(F, base) ALERT_REPEAT_B8(F, (base) + 0x100)
+#define ALERT_REPEAT_B10(F, base) ALERT_REPEAT_B9(F, base) ALERT_REPEAT_B9(F, (base) + 0x200)
+#define ALERT_REPEAT_B11(F, base) ALERT_REPEAT_B10(F, base) ALERT_REPEAT_B10(F, (base) + 0x400)
+#define ALERT_REPEAT_B12(F, base) ALERT_REPEAT_B11(F, base) ALERT_REPEAT_B11(F, (base) + 0x800)
+
+#if ALERT_KEY_BITS <= 1
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B1
+#elif ALERT_KEY_BITS == 2
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B2
+#elif ALERT_KEY_BITS == 3
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B3
+#elif ALERT_KEY_BITS == 4
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B4
+#elif ALERT_KEY_BITS == 5
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B5
+#elif ALERT_KEY_BITS == 6
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B6
+#elif ALERT_KEY_BITS == 7
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B7
+#elif ALERT_KEY_BITS == 8
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B8
+#elif ALERT_KEY_BITS == 9
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B9
+#elif ALERT_KEY_BITS == 10
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B10
+#elif ALERT_KEY_BITS == 11
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B11
+#elif ALERT_KEY_BITS == ALERT_LUT_MAX_BITS
+#define ALERT_LUT_REPEAT ALERT_REPEAT_B12
+#else
+#error "Chave de regras acima de ALERT_LUT_MAX_BITS bits: menos sensores ou severidades"
+#endif
+
+static const AlertRuleResult_t alert_rule_lut[] = {
+    ALERT_LUT_REPEAT(ALERT_LUT_ENTRY, 0)
+};
+
+_Static_assert(ALERT_SEVERITY_LEVELS == ALERT_SEVERITY_COUNT,
+               "ALERT_SEVERITY_LEVELS (config.h) deve acompanhar AlertSeverity_t");
+_Static_assert(ALERT_SENSOR_COUNT_PP == ALERT_SENSOR_COUNT, "contagem de sensores inconsistente");
+_Static_assert(sizeof(alert_rule_lut) / sizeof(alert_rule_lut[0]) >= ALERT_LUT_SIZE,
+               "a tabela de regras deve cobrir todas as chaves");
+
+// --- Limiares ---
+
+#define ALERT_EXPAND(...) __VA_ARGS__
+#define ALERT_THRESHOLD_ROW(name, thresholds, ...) { ALERT_EXPAND thresholds },
+#define ALERT_THRESHOLD_ARITY(name, thresholds, ...) \
+    _Static_assert(sizeof((int32_t[]){ ALERT_EXPAND thresholds }) == sizeof(int32_t) * (ALERT_SEVERITY_COUNT - 1), \
+                   "ALERT_SENSOR_TABLE: " #name " precisa de um limiar por severidade acima de NONE");
+
+ALERT_SENSOR_TABLE(ALERT_THRESHOLD_ARITY, ~)
+
+static const int32_t alert_thresholds[ALERT_SENSOR_COUNT][ALERT_SEVERITY_COUNT - 1] = {
+    ALERT_SENSOR_TABLE(ALERT_THRESHOLD_ROW, ~)
+};
+
+// --- Avaliação em tempo de execução ---
+
+/**
+ * @brief Monta a chave da tabela a partir dos valores atuais dos sensores.
+ *        A severidade de cada sensor é a soma das comparações com seus limiares,
+ *        sem desvios; os laços têm limites constantes e são desenrolados pelo compilador.
+ *
+ * @param values Valor de cada sensor, indexado por AlertSensor_t.
+ */
+uint32_t alert_rules_key(const int32_t values[ALERT_SENSOR_COUNT]) {
+    uint32_t key = 0;
+    for (uint32_t s = 0; s < ALERT_SENSOR_COUNT; ++s) {
+        uint32_t tier = 0;
+        for (uint32_t t = 0; t < ALERT_SEVERITY_COUNT - 1; ++t) {
+            tier += (uint32_t)(values[s] >= alert_thresholds[s][t]);
+        }
+        key |= tier << (ALERT_TIER_BITS * s);
+    }
+    return key;
+}
+
+/**
+ * @brief Avalia todas as regras com uma única consulta à tabela pré-gerada.
+ *
+ * @param values Valor de cada sensor, indexado por AlertSensor_t.
+ * @return Nível de alerta da regra de maior prioridade que casou e a severidade resultante.
+ */
+AlertRuleResult_t alert_rules_evaluate(const int32_t values[ALERT_SENSOR_COUNT]) {
+    return alert_rule_lut[alert_rules_key(values)];
+}
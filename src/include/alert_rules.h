@@ -0,0 +1,68 @@
+#ifndef ALERT_RULES_H
+#define ALERT_RULES_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Motor de regras de alerta gerado em tempo de compilação.
+//
+// Cada sensor é classificado em um nível de severidade por comparações sem desvio
+// contra os limiares da tabela ALERT_SENSOR_TABLE. Os níveis de todos os sensores,
+// ALERT_TIER_BITS cada, formam uma chave que indexa uma tabela plana gerada pelo
+// pré-processador a partir de ALERT_RULE_TABLE. Avaliar as regras custa sempre as
+// comparações dos limiares mais uma única consulta à tabela. O tamanho da tabela e
+// o número de bits por sensor saem das próprias tabelas: acrescentar um sensor ou
+// uma severidade é só mais uma entrada (a tabela tem no máximo ALERT_LUT_MAX_BITS bits de chave).
+
+// --- Tabela de sensores ---
+// X(nome, (limiar de cada severidade acima de NONE), ...) — limiares em unidades do
+// próprio sensor, na ordem de AlertSeverity_t (vigilância, aviso, emergência).
+#define ALERT_SENSOR_TABLE(X, ...) \
+    X(WATER, (WATER_LEVEL_WATCH_THRESHOLD * 10, WATER_LEVEL_ALERT_THRESHOLD * 10, WATER_LEVEL_EMERGENCY_THRESHOLD * 10), __VA_ARGS__) \
+    X(RAIN,  (RAIN_VOLUME_WATCH_THRESHOLD * 10, RAIN_VOLUME_ALERT_THRESHOLD * 10, RAIN_VOLUME_EMERGENCY_THRESHOLD * 10), __VA_ARGS__) \
+    X(RISE,  (TREND_WATCH_PERMILLE_PER_MIN,     TREND_RAPID_RISE_PERMILLE_PER_MIN, TREND_EMERGENCY_PERMILLE_PER_MIN),    __VA_ARGS__)
+
+// --- Tabela de regras (ordem = prioridade) ---
+// X(nível de alerta, severidade mínima, requisitos, ...) — requisitos montados com
+// ALERT_REQ(sensor, severidade); a regra casa quando todos os sensores atingem o exigido.
+#define ALERT_RULE_TABLE(X, ...) \
+    X(ALERT_BOTH_HIGH,  ALERT_SEVERITY_EMERGENCY, ALERT_REQ(WATER, ALERT_SEVERITY_WARNING) | ALERT_REQ(RAIN, ALERT_SEVERITY_WARNING), __VA_ARGS__) \
+    X(ALERT_WATER_HIGH, ALERT_SEVERITY_WARNING,   ALERT_REQ(WATER, ALERT_SEVERITY_WARNING), __VA_ARGS__) \
+    X(ALERT_RAPID_RISE, ALERT_SEVERITY_WARNING,   ALERT_REQ(RISE, ALERT_SEVERITY_WARNING),  __VA_ARGS__) \
+    X(ALERT_RAIN_HIGH,  ALERT_SEVERITY_WARNING,   ALERT_REQ(RAIN, ALERT_SEVERITY_WARNING),  __VA_ARGS__)
+
+#define ALERT_SENSOR_ENUM(name, thresholds, ...) ALERT_SENSOR_##name,
+typedef enum {
+    ALERT_SENSOR_TABLE(ALERT_SENSOR_ENUM, ~)
+    ALERT_SENSOR_COUNT
+} AlertSensor_t;
+
+// Contagem de sensores visível ao pré-processador (usada em #if para gerar a tabela)
+#define ALERT_PP_ONE(...)        + 1
+#define ALERT_SENSOR_COUNT_PP    (0 ALERT_SENSOR_TABLE(ALERT_PP_ONE, ~))
+
+// Bits por sensor: o menor campo que guarda as ALERT_SEVERITY_LEVELS severidades
+#if ALERT_SEVERITY_LEVELS <= 2
+#define ALERT_TIER_BITS 1
+#elif ALERT_SEVERITY_LEVELS <= 4
+#define ALERT_TIER_BITS 2
+#elif ALERT_SEVERITY_LEVELS <= 8
+#define ALERT_TIER_BITS 3
+#else
+#error "ALERT_SEVERITY_LEVELS acima de 8 não é suportado"
+#endif
+
+#define ALERT_KEY_BITS         (ALERT_TIER_BITS * ALERT_SENSOR_COUNT_PP)
+#define ALERT_LUT_MAX_BITS     12 // 4096 entradas de 2 bytes
+#define ALERT_LUT_SIZE         (1u << ALERT_KEY_BITS)
+#define ALERT_REQ(name, tier)  ((uint32_t)(tier) << (ALERT_TIER_BITS * ALERT_SENSOR_##name))
+
+typedef struct {
+    uint8_t level;    // AlertLevel_t
+    uint8_t severity; // AlertSeverity_t
+} AlertRuleResult_t;
+
+AlertRuleResult_t alert_rules_evaluate(const int32_t values[ALERT_SENSOR_COUNT]);
+uint32_t alert_rules_key(const int32_t values[ALERT_SENSOR_COUNT]);
+
+#endif // ALERT_RULES_H
@@ -13,6 +13,7 @@
 #include "hardware/adc.h" 
 
 #include "joystick.h"     
+#include "sensor_filter.h"
 #include "buzzer.h"   
 
 // FreeRTOS includes
@@ -20,24 +21,45 @@
 
 
 // --- Estruturas de Dados para Filas ---
+#define SENSOR_BLOCK_LEN 4 // Leituras por mensagem em xSensorDataQueue (ajustável; ver estatísticas de trocas de contexto)
+
+// Lote de leituras filtradas em layout de estrutura de vetores (SoA): a tarefa de
+// processamento recebe SENSOR_BLOCK_LEN leituras por canal a cada despertar.
 typedef struct {
-    uint16_t water_level_raw;     // Leitura crua do ADC para nível da água (0-4095)
-    uint16_t rain_volume_raw;     // Leitura crua do ADC para volume de chuva (0-4095)
-    uint8_t water_level_percent;  // Nível da água convertido para percentual (0-100)
-    uint8_t rain_volume_percent;  // Volume de chuva convertido para percentual (0-100)
-} SensorData_t;
+    uint8_t count;                                  // Leituras válidas no lote (1..SENSOR_BLOCK_LEN)
+    uint32_t timestamp_us[SENSOR_BLOCK_LEN];        // Instante de cada leitura (time_us_32)
+    uint16_t water_level_permille[SENSOR_BLOCK_LEN]; // Nível da água em permilagem (0-1000, resolução de 0,1%)
+    uint16_t rain_volume_permille[SENSOR_BLOCK_LEN]; // Volume de chuva em permilagem (0-1000, resolução de 0,1%)
+} SensorBlock_t;
 
 typedef enum {
     ALERT_NONE,         // Sem alerta, tudo normal
     ALERT_WATER_HIGH,   // Alerta: nível da água alto
     ALERT_RAIN_HIGH,    // Alerta: volume de chuva alto
-    ALERT_BOTH_HIGH     // Alerta: ambos os níveis altos (situação crítica)
+    ALERT_BOTH_HIGH,    // Alerta: ambos os níveis altos (situação crítica)
+    ALERT_RAPID_RISE    // Alerta: nível da água subindo rapidamente (ainda abaixo do limiar)
 } AlertLevel_t;
 
+// Ao acrescentar uma severidade, atualize ALERT_SEVERITY_LEVELS e dê a cada sensor de
+// ALERT_SENSOR_TABLE (alert_rules.h) um limiar para ela.
+typedef enum {
+    ALERT_SEVERITY_NONE,      // Todos os sensores abaixo do limiar de vigilância
+    ALERT_SEVERITY_WATCH,     // Vigilância: algum sensor se aproximando do limiar
+    ALERT_SEVERITY_WARNING,   // Aviso: limiar de alerta atingido
+    ALERT_SEVERITY_EMERGENCY, // Emergência: limiar extremo ou combinação de alertas
+    ALERT_SEVERITY_COUNT
+} AlertSeverity_t;
+#define ALERT_SEVERITY_LEVELS 4 // = ALERT_SEVERITY_COUNT, visível ao pré-processador
+
 typedef struct {
     AlertLevel_t level;             // O tipo de alerta atual
+    AlertSeverity_t severity;       // Severidade calculada pelo motor de regras (alert_rules.c)
     uint8_t water_level_percent;  // Percentual do nível da água no momento do alerta
     uint8_t rain_volume_percent;  // Percentual do volume de chuva no momento do alerta
+    int16_t water_rise_per_min;   // Tendência do nível da água em permilagem por minuto (positiva = subindo)
+    int16_t seconds_to_threshold; // Previsão (Holt) de segundos até WATER_LEVEL_ALERT_THRESHOLD; -1 = sem previsão
+    uint8_t water_max_1h_percent; // Maior nível da água na última hora (sensor_history.c)
+    uint32_t sample_timestamp_us; // Instante da leitura mais recente (base da latência fim a fim)
     bool is_alert_active;         // Flag indicando se qualquer alerta está ativo
 } AlertStatus_t;
 
@@ -50,7 +72,7 @@ typedef struct {
 #define JOYSTICK_ADC_X_CHAN 0
 #define JOYSTICK_ADC_Y_CHAN 1
 
-#define BUTTON_A_PIN    5   // Usado para alternar modos (Normal/Alerta Manual - opcional) ou outra função
+#define BUTTON_A_PIN    5   // Alterna o modo noturno (brilho reduzido) da matriz de LEDs
 #define BUTTON_B_PIN    6   // Pode ser usado para reset BOOTSEL ou outra função
 
 // LED RGB (usado para status geral de alerta)
@@ -62,8 +84,30 @@ typedef struct {
 #define MATRIX_WS2812_PIN 7
 #define MATRIX_SIZE       25
 #define MATRIX_DIM        5
-#define MATRIX_PIO_INSTANCE pio0
-#define MATRIX_PIO_SM       0
+#define MATRIX_PIO_INSTANCE pio0 // A máquina de estados é reservada na inicialização (led_strip.h)
+#define MATRIX_RESET_US     80  // Linha baixa que trava as cores (WS2812B > 50 us, SK6812 > 80 us)
+#define MATRIX_BRIGHTNESS       38 // Brilho global (0-255), ~15% como o antigo fator 0.15f
+#define MATRIX_BRIGHTNESS_NIGHT 6  // Modo noturno, alternado pelo botão A
+#define BUTTON_DEBOUNCE_MS      200
+
+// --- Animação da matriz (led_anim.h) ---
+// Um timer do FreeRTOS acorda a tarefa da matriz a MATRIX_ANIM_FPS enquanto a cena
+// é animada; cenas estáticas não geram passos.
+#define MATRIX_ANIM_FPS               25
+#define MATRIX_ANIM_MAX_KEYFRAMES     MATRIX_DIM
+#define MATRIX_ANIM_RAIN_HOLD_MS      120 // Gotas descendo uma linha por quadro-chave
+#define MATRIX_ANIM_RAIN_FADE_MS      80
+#define MATRIX_ANIM_WATER_HOLD_MS     120 // Água subindo até o nível atual
+#define MATRIX_ANIM_WATER_FADE_MS     120
+#define MATRIX_ANIM_WATER_TOP_HOLD_MS 800
+#define MATRIX_ANIM_PULSE_HOLD_MS     200 // Alerta duplo pulsando entre laranja e vermelho
+#define MATRIX_ANIM_PULSE_FADE_MS     300
+#define MATRIX_ANIM_RISE_HOLD_MS      100 // Seta de subida rápida
+#define MATRIX_ANIM_RISE_FADE_MS      60
+
+// --- Envio assíncrono da matriz (ws2812_dma.h) ---
+#define MATRIX_TX_NOTIFY_INDEX 0  // Índice de notificação de fim de envio (o 1 é do state_bus)
+#define MATRIX_TX_TIMEOUT_MS   10 // 25 LEDs levam ~0,8 ms incluindo o reset
 
 // Buzzer
 #define BUZZER_PIN_MAIN     10 // Renomeado de BUZZER_PIN1
@@ -85,9 +129,40 @@ typedef struct {
 #define ADC_CENTER         ((ADC_MAX_VALUE + ADC_MIN_VALUE) / 2)
 #define ADC_DEADZONE       50    
 
+// --- Captura contínua do ADC via DMA ---
+#define ADC_CAPTURE_CLOCK_HZ        48000000 // Clock do ADC (clk_adc)
+#define ADC_CAPTURE_CHANNEL_COUNT   2        // Canais em round-robin: água (X) e chuva (Y)
+#define ADC_CAPTURE_SAMPLE_RATE_HZ  1280     // Taxa de amostragem por canal
+#define ADC_CAPTURE_BLOCK_SAMPLES   64       // Amostras por canal em cada bloco (50 ms @ 1280 Hz)
+#define ADC_CAPTURE_WATER_SLOT      0        // Posição do canal de água dentro de cada par intercalado
+#define ADC_CAPTURE_RAIN_SLOT       1        // Posição do canal de chuva dentro de cada par intercalado
+
+// --- Filtro de sobreamostragem/decimação (entre a captura e vDataProcessingTask) ---
+#define SENSOR_FILTER_MODE          SENSOR_FILTER_BOXCAR // SENSOR_FILTER_BOXCAR ou SENSOR_FILTER_IIR
+#define SENSOR_FILTER_OSR_LOG2      6        // Decimação 64:1 -> 1280 Hz / 64 = 20 Hz, +3 bits efetivos
+#define SENSOR_FILTER_IIR_SHIFT     3        // alpha = 1/8 no modo IIR
+#define SENSOR_FILTER_REPORT_BLOCKS 200      // Blocos entre relatórios de custo do filtro (~10 s)
+#define SENSOR_OUTPUT_RATE_HZ       (ADC_CAPTURE_SAMPLE_RATE_HZ >> SENSOR_FILTER_OSR_LOG2) // Leituras filtradas por segundo
+#define SENSOR_STATS_INTERVAL_MS    10000    // Intervalo dos relatórios de trocas de contexto
+
 // Limiares para Alerta (Percentual)
-#define WATER_LEVEL_ALERT_THRESHOLD 70 // 70%
-#define RAIN_VOLUME_ALERT_THRESHOLD 80 // 80%
+#define WATER_LEVEL_WATCH_THRESHOLD     50 // 50% - vigilância
+#define WATER_LEVEL_ALERT_THRESHOLD     70 // 70% - aviso
+#define WATER_LEVEL_EMERGENCY_THRESHOLD 90 // 90% - emergência
+#define RAIN_VOLUME_WATCH_THRESHOLD     60 // 60% - vigilância
+#define RAIN_VOLUME_ALERT_THRESHOLD     80 // 80% - aviso
+#define RAIN_VOLUME_EMERGENCY_THRESHOLD 95 // 95% - emergência
+
+// Tendência do nível da água (mínimos quadrados em janela deslizante)
+#define TREND_WINDOW_SAMPLES              100 // 5 s de leituras a 20 Hz (máx. TREND_MAX_WINDOW)
+#define TREND_WATCH_PERMILLE_PER_MIN      300  // Subida de 30%/min - vigilância
+#define TREND_RAPID_RISE_PERMILLE_PER_MIN 600  // Subida de 60%/min dispara o alerta de subida rápida
+#define TREND_EMERGENCY_PERMILLE_PER_MIN  1200 // Subida de 120%/min - emergência
+
+// Previsão de tempo até o limiar (suavização exponencial dupla de Holt)
+#define FORECAST_ALPHA_SHIFT 3   // alpha = 1/8 (suavização do nível)
+#define FORECAST_BETA_SHIFT  6   // beta = 1/64 (suavização da tendência)
+#define FORECAST_HORIZON_S   300 // Previsões além de 5 min são descartadas
 
 // --- Tempos do Buzzer para Alerta (ms) ---
 #define BUZZER_ALERT_WATER_FREQ     880 // A5
@@ -102,15 +177,43 @@ typedef struct {
 #define BUZZER_ALERT_BOTH_ON_MS     150
 #define BUZZER_ALERT_BOTH_OFF_MS    150
 
+#define BUZZER_ALERT_RISE_FREQ      660 // E5 (grave, bipes longos)
+#define BUZZER_ALERT_RISE_ON_MS     500
+#define BUZZER_ALERT_RISE_OFF_MS    500
+
+// --- Histórico dos sensores (sensor_history.h) ---
+#define SENSOR_HISTORY_RAM_BUDGET 4096 // Bytes para os históricos de água e chuva (verificado em tempo de compilação)
+
+// --- Despacho por mudança no barramento de estado (state_bus.h) ---
+// Variação mínima, estritamente maior, que acorda cada consumidor. Mudanças de nível,
+// severidade ou flag de alerta sempre acordam; STATE_BUS_IGNORE desconsidera o campo.
+#define DISPATCH_DISPLAY_PERCENT_DEADBAND 0  // Display mostra o valor exato: qualquer 1% acorda
+#define DISPATCH_DISPLAY_ETA_DEADBAND_S   0  // Linha "LIMIAR EM" acompanha cada segundo
+
+// --- Envio assíncrono do display (i2c_dma.h) ---
+#define DISPLAY_TX_NOTIFY_INDEX 0   // Índice de notificação de fim de envio (o 1 é do state_bus)
+#define DISPLAY_TX_TIMEOUT_MS   100 // Tela cheia a 400 kHz leva ~25 ms
+
+// --- Atualização do display por evento ---
+// A tela só é redesenhada quando o conteúdo exibido muda; rajadas de publicações
+// dentro de um intervalo de quadro viram um único quadro com o estado mais recente.
+#define DISPLAY_MAX_FPS         5   // Teto de quadros por segundo
+#define DISPLAY_GRAPH_COLUMN_MS 5000 // Uma coluna do gráfico de água a cada 5 s (125 colunas ~ 10 min)
+
 // --- Tempos de Delay das Tarefas (ms) ---
-#define JOYSTICK_READ_DELAY_MS    200  // Frequência de leitura do joystick
 #define DATA_PROCESS_DELAY_MS     50   // Pequeno delay se não houver dados na fila
 #define BUTTON_TASK_DELAY_MS      20
-#define DISPLAY_UPDATE_DELAY_MS   500
 #define RGB_LED_TASK_DELAY_MS     100
 #define MATRIX_TASK_DELAY_MS      200
 #define BUZZER_TASK_DELAY_MS      50   // Pequeno delay base para a tarefa do buzzer
 
+// --- Afinidade de núcleo (build SMP, FLOOD_DUAL_CORE) ---
+// A IRQ do DMA do ADC é instalada no núcleo 0 (adc_capture_init roda em main),
+// então aquisição e processamento ficam nele; as saídas bloqueantes (I2C do display,
+// PIO da matriz, PWM do buzzer, GPIO do LED) ficam no núcleo 1, junto com o tick.
+#define CORE_MASK_ACQUISITION (1u << 0)
+#define CORE_MASK_OUTPUT      (1u << 1)
+
 // --- Configuração de Tarefas FreeRTOS ---
 // Prioridades
 #define PRIORITY_JOYSTICK_READ    (tskIDLE_PRIORITY + 4) // Mais alta para entrada de dados
@@ -123,7 +226,7 @@ typedef struct {
 
 // Tamanho das Stacks
 #define STACK_MULTIPLIER_DEFAULT  2
-#define STACK_MULTIPLIER_DISPLAY  4 // Display pode precisar de mais para strings
+#define STACK_MULTIPLIER_DISPLAY  4 // Reduzir só depois de ler a folga real na placa ("pilha livre" no log)
 #define STACK_SIZE_DEFAULT        (configMINIMAL_STACK_SIZE * STACK_MULTIPLIER_DEFAULT)
 #define STACK_SIZE_DISPLAY        (configMINIMAL_STACK_SIZE * STACK_MULTIPLIER_DISPLAY)
 
@@ -3,6 +3,27 @@
 #include <string.h>
 #include <stdio.h>
 #include "pico/stdlib.h"
+#include "i2c_dma.h"
+#include "text_format.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Back buffer, front buffer e buffers de transmissão do display, fora do heap do FreeRTOS
+static ssd1306_framebuffers_t display_buffers;
+
+// Estado do envio assíncrono do quadro (um por vez)
+static bool display_tx_pending = false;
+static volatile bool display_tx_failed = false;
+
+// Callback do i2c_dma (contexto de interrupção): acorda a tarefa que iniciou o envio
+static void display_tx_done(void *ctx, bool ok) {
+    BaseType_t higher_priority_woken = pdFALSE;
+    if (!ok) {
+        display_tx_failed = true;
+    }
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)ctx, DISPLAY_TX_NOTIFY_INDEX, &higher_priority_woken);
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
 
 
 /**
@@ -22,12 +43,29 @@
     gpio_pull_up(I2C_SDA_PIN);
     gpio_pull_up(I2C_SCL_PIN);
      // Inicializa a estrutura do driver SSD1306 com os parâmetros do display
-    ssd1306_init(ssd, WIDTH, HEIGHT, false, DISPLAY_ADDR, I2C_PORT);
+    ssd1306_init_buffered(ssd, WIDTH, HEIGHT, false, DISPLAY_ADDR, I2C_PORT, &display_buffers);
      // Envia a sequência de comandos de configuração para o display
     ssd1306_config(ssd);
     ssd1306_fill(ssd, false);
+    ssd1306_present(ssd);
     ssd1306_send_data(ssd);
-    printf("Display inicializado.\n");
+    printf("Display inicializado (sequencia de configuracao em %lu us).\n", (unsigned long)ssd->config_us);
+}
+
+/**
+  * @brief Registra o I2C do display no i2c_dma para os envios assíncronos
+  *        (display_send_async). A IRQ do I2C é instalada no núcleo de quem chama,
+  *        então a chamada fica no início da tarefa do display, presa ao núcleo
+  *        das saídas, e não em main().
+  *
+  * @return false se não há canal DMA livre.
+  */
+bool display_start_dma(void) {
+    if (!i2c_dma_init(I2C_PORT)) {
+        printf("Display: sem canal DMA livre para o I2C.\n");
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -54,10 +92,240 @@
     ssd1306_draw_string(ssd, line2, center_x_approx - (strlen(line2)*8)/2, start_y + line_height);
     ssd1306_draw_string(ssd, line3, center_x_approx - (strlen(line3)*8)/2, start_y + 2*line_height);
     ssd1306_draw_string(ssd, line4, center_x_approx - (strlen(line4)*8)/2, start_y + 3*line_height);
+    ssd1306_present(ssd);
     ssd1306_send_data(ssd);
+    printf("Display: quadro de %lu bytes, enderecamento das janelas em %lu us\n",
+        (unsigned long)ssd->bytes_sent_last, (unsigned long)ssd->window_setup_us_last);
     // Mantém a tela visível por um tempo
     sleep_ms(2500);
     // Limpa o display após a tela de inicialização
     ssd1306_fill(ssd, false);
+    ssd1306_present(ssd);
     ssd1306_send_data(ssd);
 }
+
+/**
+  * @brief Desenha uma linha de texto completada com espaços até DISPLAY_LINE_CHARS.
+  *        Cada caractere grava também os pixels de fundo da sua célula, então o texto
+  *        anterior é apagado sem limpar a tela, e o driver só marca como sujos os bytes
+  *        que realmente mudaram.
+  *
+  * @param ssd Ponteiro para a estrutura de controle do display SSD1306.
+  * @param text Texto da linha (truncado em DISPLAY_LINE_CHARS caracteres).
+  * @param y Linha superior do texto, em pixels.
+  */
+void display_draw_line(ssd1306_t *ssd, const char *text, uint8_t y) {
+    char padded[DISPLAY_LINE_CHARS + 1];
+    text_line_t line;
+    text_init(&line, padded, sizeof(padded));
+    text_str(&line, text);
+    text_pad(&line, DISPLAY_LINE_CHARS);
+    ssd1306_draw_string(ssd, padded, DISPLAY_TEXT_X, y);
+}
+
+/**
+  * @brief Como display_draw_line, para textos fixos (rótulos e mensagens de status):
+  *        a linha completada é copiada de uma faixa pré-renderizada do cache do driver.
+  */
+void display_draw_label(ssd1306_t *ssd, const char *text, uint8_t y) {
+    char padded[DISPLAY_LINE_CHARS + 1];
+    text_line_t line;
+    text_init(&line, padded, sizeof(padded));
+    text_str(&line, text);
+    text_pad(&line, DISPLAY_LINE_CHARS);
+    ssd1306_draw_text_cached(ssd, &ssd1306_font_8x8, padded, DISPLAY_TEXT_X, y);
+}
+
+/**
+  * @brief Envia o que estiver sujo no buffer (ex.: uma coluna nova do gráfico)
+  *        sem redesenhar o quadro.
+  *
+  * @return true se uma transmissão foi iniciada.
+  */
+bool display_flush(ssd1306_t *ssd) {
+    if (!display_wait_sent(ssd, pdMS_TO_TICKS(DISPLAY_TX_TIMEOUT_MS))) {
+        return false;
+    }
+    return display_send_async(ssd);
+}
+
+/**
+  * @brief Apresenta o back buffer e inicia o envio assíncrono (DMA) do que mudou
+  *        em relação ao front buffer, retornando em seguida.
+  *        Deve ser chamada por uma tarefa, após display_wait_sent() do quadro anterior.
+  *
+  * @param ssd Ponteiro para a estrutura de controle do display SSD1306.
+  * @return true se uma transmissão foi iniciada.
+  */
+bool display_send_async(ssd1306_t *ssd) {
+    if (display_tx_pending) {
+        return false; // Envio anterior ainda em andamento: o quadro é apresentado no próximo
+    }
+    ssd1306_present(ssd);
+    display_tx_pending = ssd1306_send_data_async(ssd, display_tx_done, xTaskGetCurrentTaskHandle());
+    return display_tx_pending;
+}
+
+/**
+  * @brief Aguarda o fim do envio iniciado por display_send_async(), se houver.
+  *        Se a transmissão foi abortada, a tela inteira é marcada para reenvio.
+  *
+  * @param ssd Ponteiro para a estrutura de controle do display SSD1306.
+  * @param timeout Tempo máximo de espera.
+  * @return true se não há envio pendente.
+  */
+bool display_wait_sent(ssd1306_t *ssd, TickType_t timeout) {
+    if (!display_tx_pending) {
+        return true;
+    }
+    if (ulTaskNotifyTakeIndexed(DISPLAY_TX_NOTIFY_INDEX, pdTRUE, timeout) == 0) {
+        return false;
+    }
+    display_tx_pending = false;
+    if (display_tx_failed) {
+        display_tx_failed = false;
+        ssd1306_mark_all_dirty(ssd);
+    }
+    return true;
+}
+
+/**
+  * @brief Extrai de um AlertStatus_t apenas o que a tela mostra.
+  *
+  * @param status Estado lido do barramento.
+  * @param model Destino; campos não exibidos ficam zerados para a comparação.
+  */
+void display_model_from_status(const AlertStatus_t *status, display_model_t *model) {
+    memset(model, 0, sizeof(*model));
+    model->water_percent = status->water_level_percent;
+    model->rain_percent = status->rain_volume_percent;
+    model->alert_active = status->is_alert_active;
+    model->eta_seconds = (status->seconds_to_threshold > 0) ? status->seconds_to_threshold : -1;
+    if (status->is_alert_active) {
+        model->level = (uint8_t)status->level;
+        // Em alerta só importa se é emergência ("! EMERGENCIA !" x "!!! ALERTA !!!")
+        model->severity = (status->severity == ALERT_SEVERITY_EMERGENCY) ? ALERT_SEVERITY_EMERGENCY : ALERT_SEVERITY_WARNING;
+    } else {
+        model->severity = (status->severity == ALERT_SEVERITY_WATCH) ? ALERT_SEVERITY_WATCH : ALERT_SEVERITY_NONE;
+        model->water_max_1h_percent = status->water_max_1h_percent;
+    }
+}
+
+// Desenha o modelo no buffer; a moldura só é desenhada no primeiro quadro
+static void display_render(ssd1306_t *ssd, const display_model_t *model, bool first_frame) {
+    char buf[DISPLAY_LINE_CHARS + 1];
+    text_line_t line;
+
+    // As linhas de texto sobrescrevem o fundo das próprias células, então a tela
+    // não é limpa e só os bytes alterados são enviados
+    if (first_frame) {
+        ssd1306_fill(ssd, false);
+        ssd1306_rect(ssd, 0, 0, 127, 63, 1, false);
+    }
+
+    // Nível da água em dígitos grandes, legíveis à distância; os rótulos vêm do cache
+    // de faixas e os valores são completados com espaços para apagar os anteriores
+    ssd1306_draw_text_cached(ssd, &ssd1306_font_prop, "NVL. AGUA", DISPLAY_TEXT_X, DISPLAY_WATER_Y + 4);
+    text_init(&line, buf, sizeof(buf));
+    text_uint(&line, model->water_percent, 3);
+    ssd1306_draw_text(ssd, &ssd1306_font_digits16, buf, DISPLAY_WATER_DIGITS_X, DISPLAY_WATER_Y);
+    ssd1306_draw_text(ssd, &ssd1306_font_8x8, "%", DISPLAY_WATER_DIGITS_X + 3 * 16, DISPLAY_WATER_Y + 8);
+
+    ssd1306_draw_text_cached(ssd, &ssd1306_font_prop, "VOL. CHUVA:", DISPLAY_TEXT_X, DISPLAY_RAIN_Y);
+    text_init(&line, buf, sizeof(buf));
+    text_uint(&line, model->rain_percent, 3);
+    text_char(&line, '%');
+    ssd1306_draw_text(ssd, &ssd1306_font_8x8, buf, DISPLAY_VALUE_X, DISPLAY_RAIN_Y);
+
+    if (model->alert_active) {
+        display_draw_label(ssd, (model->severity == ALERT_SEVERITY_EMERGENCY) ? "! EMERGENCIA !" : "!!! ALERTA !!!", DISPLAY_STATUS_Y);
+        switch (model->level) {
+            case ALERT_WATER_HIGH: display_draw_label(ssd, "Nivel Agua Alto!", DISPLAY_DETAIL_Y); break;
+            case ALERT_RAIN_HIGH:  display_draw_label(ssd, "Chuva Intensa!",   DISPLAY_DETAIL_Y); break;
+            case ALERT_BOTH_HIGH:  display_draw_label(ssd, "PERIGO MAXIMO!",   DISPLAY_DETAIL_Y); break;
+            case ALERT_RAPID_RISE: display_draw_label(ssd, "Subida Rapida!",   DISPLAY_DETAIL_Y); break;
+            default:               display_draw_label(ssd, "Alerta Ativo",     DISPLAY_DETAIL_Y); break;
+        }
+    } else {
+        display_draw_label(ssd, (model->severity == ALERT_SEVERITY_WATCH) ? "STATUS: ATENCAO" : "STATUS: NORMAL", DISPLAY_STATUS_Y);
+        text_init(&line, buf, sizeof(buf));
+        text_str(&line, "MAX 1H: ");
+        text_uint(&line, model->water_max_1h_percent, 3);
+        text_char(&line, '%');
+        display_draw_line(ssd, buf, DISPLAY_DETAIL_Y);
+    }
+
+    // Tempo estimado até o nível da água atingir o limiar de alerta (lead time)
+    text_init(&line, buf, sizeof(buf));
+    if (model->eta_seconds > 0) {
+        text_str(&line, "LIMIAR EM ");
+        text_int(&line, model->eta_seconds, 3);
+        text_char(&line, 's');
+    }
+    display_draw_line(ssd, buf, DISPLAY_ETA_Y);
+}
+
+/**
+  * @brief Inicializa a agenda de quadros.
+  *
+  * @param sched Agenda.
+  * @param max_fps Teto de quadros por segundo (0 = sem teto).
+  */
+void display_scheduler_init(display_scheduler_t *sched, uint32_t max_fps) {
+    memset(sched, 0, sizeof(*sched));
+    sched->min_interval = (max_fps > 0) ? pdMS_TO_TICKS(1000 / max_fps) : 0;
+}
+
+/**
+  * @brief Tempo até o próximo quadro permitido pelo teto de FPS.
+  *
+  * @return Ticks a esperar (0 = pode desenhar agora).
+  */
+TickType_t display_scheduler_delay(const display_scheduler_t *sched) {
+    if (!sched->has_frame) {
+        return 0;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - sched->last_frame;
+    return (elapsed < sched->min_interval) ? sched->min_interval - elapsed : 0;
+}
+
+/**
+  * @brief Desenha e envia um quadro se o modelo difere do que está na tela.
+  *        Modelos repetidos não tocam no buffer nem no barramento I2C.
+  *
+  * @param sched Agenda.
+  * @param ssd Ponteiro para a estrutura de controle do display SSD1306.
+  * @param model Conteúdo desejado.
+  * @return true se um quadro foi desenhado.
+  */
+bool display_scheduler_submit(display_scheduler_t *sched, ssd1306_t *ssd, const display_model_t *model) {
+    if (sched->has_frame && memcmp(&sched->shown, model, sizeof(*model)) == 0) {
+        sched->skipped++;
+        return false;
+    }
+
+    uint32_t render_start_us = time_us_32();
+    display_render(ssd, model, !sched->has_frame);
+    uint32_t render_us = time_us_32() - render_start_us;
+
+    // O envio anterior terminou durante a espera do teto de FPS;
+    // este segue por DMA enquanto a tarefa fica livre
+    if (!display_wait_sent(ssd, pdMS_TO_TICKS(DISPLAY_TX_TIMEOUT_MS))) {
+        sched->tx_timeouts++;
+    }
+    uint32_t send_start_us = time_us_32();
+    display_send_async(ssd);
+    uint32_t frame_us = render_us + (time_us_32() - send_start_us);
+
+    sched->shown = *model;
+    sched->has_frame = true;
+    sched->last_frame = xTaskGetTickCount();
+    sched->rendered++;
+    sched->frame_us_last = frame_us;
+    if (frame_us > sched->frame_us_max) {
+        sched->frame_us_max = frame_us;
+    }
+    // Menor folga de pilha já vista pela tarefa que desenha (base para STACK_MULTIPLIER_DISPLAY)
+    sched->stack_free_words = uxTaskGetStackHighWaterMark(NULL);
+    return true;
+}
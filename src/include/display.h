@@ -5,8 +5,63 @@
 #include <stdbool.h>
 #include "config.h"
 #include "lib/ssd1306/ssd1306.h"
+#include "FreeRTOS.h"
+
+#define DISPLAY_TEXT_X     3  // Margem esquerda das linhas de texto (dentro da moldura)
+#define DISPLAY_LINE_CHARS 15 // Caracteres de 8 px que cabem entre a margem e a borda direita
+#define DISPLAY_WATER_Y        2   // Topo dos dígitos grandes do nível da água (16 px de altura)
+#define DISPLAY_WATER_DIGITS_X 68  // 3 dígitos de 16 px + '%' de 8 px terminam na coluna 123
+#define DISPLAY_VALUE_X        92  // Valores de 4 caracteres de 8 px alinhados à direita
+#define DISPLAY_RAIN_Y         20
+#define DISPLAY_STATUS_Y       29
+#define DISPLAY_DETAIL_Y       38  // Tipo de alerta ou máximo da última hora
+#define DISPLAY_ETA_Y          47  // "LIMIAR EM"
+
+// Gráfico do nível da água (sparkline.h): linhas 56-61, acima da borda inferior da
+// moldura (linha 62) e dentro da página 7, então cada coluna nova é um byte no barramento
+#define DISPLAY_GRAPH_X      1
+#define DISPLAY_GRAPH_Y      56
+#define DISPLAY_GRAPH_WIDTH  125
+#define DISPLAY_GRAPH_HEIGHT 6
+
+// Conteúdo visível da tela da tarefa do display. Dois modelos iguais (memcmp)
+// produzem o mesmo quadro, então campos que não aparecem ficam zerados.
+typedef struct {
+    int16_t eta_seconds;          // Linha "LIMIAR EM"; -1 = linha vazia
+    uint8_t water_percent;
+    uint8_t rain_percent;
+    uint8_t severity;             // AlertSeverity_t (só distingue as linhas de status)
+    uint8_t level;                // AlertLevel_t; ALERT_NONE fora de alerta
+    uint8_t water_max_1h_percent; // Só exibido fora de alerta
+    bool alert_active;
+} display_model_t;
+
+// Agenda de quadros: desenha só quando o modelo muda, no máximo DISPLAY_MAX_FPS por segundo
+typedef struct {
+    display_model_t shown;     // Modelo do último quadro desenhado
+    bool has_frame;            // false até o primeiro quadro (moldura ainda não desenhada)
+    TickType_t last_frame;     // Tick do último quadro
+    TickType_t min_interval;   // Intervalo mínimo entre quadros
+    uint32_t rendered;         // Quadros desenhados e enviados
+    uint32_t skipped;          // Acordadas sem mudança visível (nada desenhado nem enviado)
+    uint32_t coalesced;        // Esperas do teto de FPS que absorveram novas publicações
+    uint32_t tx_timeouts;      // Quadros cujo envio anterior não terminou em DISPLAY_TX_TIMEOUT_MS
+    uint32_t frame_us_last;    // CPU por quadro: desenho + apresentação + montagem do fluxo DMA
+    uint32_t frame_us_max;
+    UBaseType_t stack_free_words; // Marca d'água da pilha da tarefa do display (palavras livres)
+} display_scheduler_t;
 
 void display_init(ssd1306_t *ssd); 
 void display_startup_screen(ssd1306_t *ssd);
+bool display_start_dma(void);
+void display_draw_line(ssd1306_t *ssd, const char *text, uint8_t y);
+void display_draw_label(ssd1306_t *ssd, const char *text, uint8_t y);
+bool display_send_async(ssd1306_t *ssd);
+bool display_flush(ssd1306_t *ssd);
+bool display_wait_sent(ssd1306_t *ssd, TickType_t timeout);
+void display_model_from_status(const AlertStatus_t *status, display_model_t *model);
+void display_scheduler_init(display_scheduler_t *sched, uint32_t max_fps);
+TickType_t display_scheduler_delay(const display_scheduler_t *sched);
+bool display_scheduler_submit(display_scheduler_t *sched, ssd1306_t *ssd, const display_model_t *model);
 
 #endif // DISPLAY_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "forecast.h"
+
+/**
+ * @brief Inicializa o previsor.
+ *
+ * @param f Previsor.
+ * @param alpha_shift Suavização do nível (alpha = 1/2^alpha_shift).
+ * @param beta_shift Suavização da tendência (beta = 1/2^beta_shift).
+ */
+void forecast_init(forecast_t *f, uint8_t alpha_shift, uint8_t beta_shift) {
+    f->level_q16 = 0;
+    f->trend_q16 = 0;
+    f->alpha_shift = alpha_shift;
+    f->beta_shift = beta_shift;
+    f->primed = false;
+}
+
+/**
+ * @brief Atualiza nível e tendência com uma nova leitura (Holt):
+ *        L = (L + T) + alpha * (y - (L + T))
+ *        T = T + beta * ((L - L_anterior) - T)
+ *
+ * @param f Previsor.
+ * @param value Nova leitura (ex.: nível da água em permilagem, até ±32767).
+ */
+void forecast_update(forecast_t *f, int32_t value) {
+    int32_t y_q16 = value * (1 << FORECAST_FRAC_BITS);
+
+    if (!f->primed) {
+        f->level_q16 = y_q16;
+        f->trend_q16 = 0;
+        f->primed = true;
+        return;
+    }
+
+    int32_t previous_level = f->level_q16;
+    int32_t predicted = f->level_q16 + f->trend_q16;
+    f->level_q16 = predicted + ((y_q16 - predicted) >> f->alpha_shift);
+    f->trend_q16 += ((f->level_q16 - previous_level) - f->trend_q16) >> f->beta_shift;
+}
+
+/**
+ * @brief Estima em quantos segundos o nível suavizado atinge `threshold`
+ *        mantida a tendência atual.
+ *
+ * @param f Previsor.
+ * @param threshold Limiar, nas mesmas unidades das leituras.
+ * @param sample_rate_hz Taxa com que forecast_update() é chamada.
+ * @param max_seconds Horizonte máximo; estimativas além dele são descartadas.
+ * @return Segundos até o limiar, 0 se já o atingiu, ou FORECAST_NO_ESTIMATE se
+ *         o nível não está subindo ou o cruzamento está além do horizonte.
+ */
+int32_t forecast_seconds_to(const forecast_t *f, int32_t threshold, uint32_t sample_rate_hz, int32_t max_seconds) {
+    if (!f->primed || sample_rate_hz == 0) {
+        return FORECAST_NO_ESTIMATE;
+    }
+
+    int32_t gap_q16 = threshold * (1 << FORECAST_FRAC_BITS) - f->level_q16;
+    if (gap_q16 <= 0) {
+        return 0;
+    }
+    if (f->trend_q16 <= 0) {
+        return FORECAST_NO_ESTIMATE;
+    }
+
+    // Amostras até o limiar = gap / tendência
+    uint32_t samples = (uint32_t)gap_q16 / (uint32_t)f->trend_q16;
+    uint32_t seconds = samples / sample_rate_hz;
+    if (seconds > (uint32_t)max_seconds) {
+        return FORECAST_NO_ESTIMATE;
+    }
+    return (int32_t)seconds;
+}
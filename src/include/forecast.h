@@ -0,0 +1,27 @@
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Previsão de tempo até o limiar por suavização exponencial dupla (Holt).
+// Estado constante (nível e tendência em Q16), apenas aritmética inteira e
+// coeficientes na forma 1/2^n, de modo que cada atualização custa somas e shifts.
+// Não depende do Pico SDK: pode ser reproduzido no host a partir de séries gravadas.
+
+#define FORECAST_FRAC_BITS   16
+#define FORECAST_NO_ESTIMATE (-1)
+
+typedef struct {
+    int32_t level_q16;  // Nível suavizado (unidades de entrada << 16)
+    int32_t trend_q16;  // Tendência suavizada por amostra (unidades de entrada << 16)
+    uint8_t alpha_shift; // alpha = 1 / 2^alpha_shift
+    uint8_t beta_shift;  // beta  = 1 / 2^beta_shift
+    bool primed;
+} forecast_t;
+
+void forecast_init(forecast_t *f, uint8_t alpha_shift, uint8_t beta_shift);
+void forecast_update(forecast_t *f, int32_t value);
+int32_t forecast_seconds_to(const forecast_t *f, int32_t threshold, uint32_t sample_rate_hz, int32_t max_seconds);
+
+#endif // FORECAST_H
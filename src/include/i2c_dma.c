@@ -0,0 +1,122 @@
+#include "i2c_dma.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// --- Internal Definitions ---
+static i2c_inst_t *dma_i2c = NULL;
+static int dma_chan = -1;
+static volatile bool dma_in_flight = false;
+static i2c_dma_callback_t dma_callback = NULL;
+static void *dma_callback_ctx = NULL;
+
+// Encerra a transmissão atual: desliga as interrupções do I2C (para não interferir
+// com i2c_write_blocking, que consulta o TX_ABRT por conta própria) e avisa o dono.
+static void i2c_dma_finish(bool ok) {
+    i2c_get_hw(dma_i2c)->intr_mask = 0;
+    dma_in_flight = false;
+    if (dma_callback != NULL) {
+        dma_callback(dma_callback_ctx, ok);
+    }
+}
+
+/**
+ * @brief Handler da IRQ do I2C. Cada transação do fluxo gera um STOP_DET; a
+ *        transmissão termina no STOP em que o DMA já entregou todas as palavras
+ *        e a FIFO de transmissão está vazia.
+ */
+static void i2c_dma_irq_handler(void) {
+    i2c_hw_t *hw = i2c_get_hw(dma_i2c);
+    uint32_t status = hw->intr_stat;
+
+    if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // Escravo não respondeu (NACK) ou perda de arbitragem: a FIFO é descartada pelo hardware
+        (void)hw->clr_tx_abrt;
+        (void)hw->clr_stop_det;
+        dma_channel_abort((uint)dma_chan);
+        if (dma_in_flight) {
+            i2c_dma_finish(false);
+        }
+        return;
+    }
+
+    if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+        if (dma_in_flight && !dma_channel_is_busy((uint)dma_chan) && (hw->status & I2C_IC_STATUS_TFE_BITS)) {
+            i2c_dma_finish(true);
+        }
+    }
+}
+
+// --- Public API Functions ---
+
+/**
+ * @brief Reserva um canal DMA e instala o handler de IRQ do I2C no núcleo atual.
+ *        O I2C deve ter sido inicializado com i2c_init().
+ */
+bool i2c_dma_init(i2c_inst_t *i2c) {
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) {
+        return false;
+    }
+
+    dma_i2c = i2c;
+    dma_chan = chan;
+
+    dma_channel_config cfg = dma_channel_get_default_config((uint)chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(i2c, true));
+    dma_channel_configure((uint)chan, &cfg, &i2c_get_hw(i2c)->data_cmd, NULL, 0, false);
+
+    i2c_get_hw(i2c)->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+    i2c_get_hw(i2c)->intr_mask = 0;
+
+    uint irq = I2C0_IRQ + i2c_get_index(i2c);
+    irq_set_exclusive_handler(irq, i2c_dma_irq_handler);
+    irq_set_enabled(irq, true);
+    return true;
+}
+
+/**
+ * @brief Inicia a transmissão de `count` palavras de IC_DATA_CMD para `addr`.
+ *        Retorna imediatamente; o buffer `words` deve permanecer válido até o callback.
+ *
+ * @param i2c Instância passada a i2c_dma_init().
+ * @param addr Endereço de 7 bits do escravo.
+ * @param words Fluxo de palavras (a última deve conter I2C_DMA_STOP).
+ * @param count Número de palavras.
+ * @param callback Chamado em contexto de interrupção ao final (ok = false se houve abort).
+ * @param ctx Argumento repassado ao callback.
+ * @return false se já houver uma transmissão em andamento ou o fluxo for inválido.
+ */
+bool i2c_dma_write(i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count,
+                   i2c_dma_callback_t callback, void *ctx) {
+    if (i2c != dma_i2c || dma_in_flight || count == 0 || !(words[count - 1] & I2C_DMA_STOP)) {
+        return false;
+    }
+
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    // O endereço do escravo só pode ser trocado com o periférico desabilitado
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+
+    dma_callback = callback;
+    dma_callback_ctx = ctx;
+    dma_in_flight = true;
+
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    dma_channel_transfer_from_buffer_now((uint)dma_chan, words, (uint32_t)count);
+    return true;
+}
+
+/**
+ * @brief Indica se há uma transmissão em andamento.
+ */
+bool i2c_dma_busy(void) {
+    return dma_in_flight;
+}
@@ -0,0 +1,29 @@
+#ifndef I2C_DMA_H
+#define I2C_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+// Transmissão I2C não bloqueante: um canal DMA alimenta o IC_DATA_CMD do
+// periférico com palavras de 16 bits (byte nos bits 0-7, STOP no bit 9), então
+// um único disparo pode conter várias transações ao mesmo escravo, cada uma
+// encerrada por uma palavra com I2C_DMA_STOP. O fim é detectado pela interrupção
+// STOP_DET com o DMA ocioso e a FIFO vazia, e sinalizado por callback (em contexto
+// de interrupção). Há uma única transmissão em andamento por vez.
+//
+// A interface não depende do FreeRTOS: no host, basta outra implementação de
+// i2c_dma_write() para gravar e verificar a sequência de palavras.
+
+#define I2C_DMA_STOP    I2C_IC_DATA_CMD_STOP_BITS    // Encerra a transação após este byte
+#define I2C_DMA_RESTART I2C_IC_DATA_CMD_RESTART_BITS // Gera RESTART antes deste byte
+
+typedef void (*i2c_dma_callback_t)(void *ctx, bool ok);
+
+bool i2c_dma_init(i2c_inst_t *i2c);
+bool i2c_dma_write(i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count,
+                   i2c_dma_callback_t callback, void *ctx);
+bool i2c_dma_busy(void);
+
+#endif // I2C_DMA_H
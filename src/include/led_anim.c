@@ -0,0 +1,100 @@
+#include "led_anim.h"
+
+// Duração total de um quadro-chave (parado + transição), nunca zero
+static inline uint32_t keyframe_span_ms(const led_anim_keyframe_t *kf) {
+    uint32_t span = (uint32_t)kf->hold_ms + kf->fade_ms;
+    return span ? span : 1;
+}
+
+// Índice do quadro-chave seguinte, ou o próprio se a sequência termina nele
+static inline uint8_t next_index(const led_anim_t *anim) {
+    if (anim->index + 1 < anim->count) {
+        return anim->index + 1;
+    }
+    return anim->loop ? 0 : anim->index;
+}
+
+/**
+ * @brief Interpolação linear inteira entre duas cores.
+ *
+ * @param t256 Posição da transição: 0 = a, 256 = b.
+ */
+led_color_t led_anim_blend(led_color_t a, led_color_t b, uint16_t t256) {
+    led_color_t out;
+    out.r = (uint8_t)(a.r + (((int32_t)b.r - a.r) * t256 >> 8));
+    out.g = (uint8_t)(a.g + (((int32_t)b.g - a.g) * t256 >> 8));
+    out.b = (uint8_t)(a.b + (((int32_t)b.b - a.b) * t256 >> 8));
+    return out;
+}
+
+/**
+ * @brief Inicia uma sequência no primeiro quadro-chave. As imagens apontadas
+ *        pelos quadros-chave devem permanecer válidas enquanto ela roda.
+ *
+ * @param anim Sequenciador.
+ * @param frames Quadros-chave.
+ * @param count Número de quadros-chave (>= 1).
+ * @param pixel_count Posições de cada imagem e do buffer de saída.
+ * @param loop Repete a sequência indefinidamente.
+ */
+void led_anim_start(led_anim_t *anim, const led_anim_keyframe_t *frames, uint8_t count,
+                    uint16_t pixel_count, bool loop) {
+    anim->frames = frames;
+    anim->count = count;
+    anim->index = 0;
+    anim->pixel_count = pixel_count;
+    anim->elapsed_ms = 0;
+    anim->loop = loop;
+}
+
+/**
+ * @brief Indica se a sequência ainda muda com o tempo (e portanto precisa de passos).
+ */
+bool led_anim_running(const led_anim_t *anim) {
+    if (anim->count <= 1) {
+        return false;
+    }
+    return anim->loop || anim->index + 1 < anim->count;
+}
+
+/**
+ * @brief Avança o relógio da sequência e escreve o quadro resultante em `out`.
+ *
+ * @param anim Sequenciador.
+ * @param dt_ms Tempo desde o passo anterior (0 = só redesenhar o quadro atual).
+ * @param out Buffer de saída com `pixel_count` posições, contendo o quadro anterior.
+ * @return true se algum pixel de `out` mudou.
+ */
+bool led_anim_step(led_anim_t *anim, uint32_t dt_ms, led_color_t *out) {
+    if (anim->count == 0) {
+        return false;
+    }
+
+    if (led_anim_running(anim)) {
+        anim->elapsed_ms += dt_ms;
+        uint32_t span = keyframe_span_ms(&anim->frames[anim->index]);
+        while (anim->elapsed_ms >= span && led_anim_running(anim)) {
+            anim->elapsed_ms -= span;
+            anim->index = next_index(anim);
+            span = keyframe_span_ms(&anim->frames[anim->index]);
+        }
+    }
+
+    const led_anim_keyframe_t *current = &anim->frames[anim->index];
+    const led_anim_keyframe_t *next = &anim->frames[next_index(anim)];
+    uint16_t t256 = 0;
+    if (led_anim_running(anim) && current->fade_ms > 0 && anim->elapsed_ms > current->hold_ms) {
+        t256 = (uint16_t)(((anim->elapsed_ms - current->hold_ms) << 8) / current->fade_ms);
+    }
+
+    bool changed = false;
+    for (uint16_t i = 0; i < anim->pixel_count; ++i) {
+        led_color_t c = (t256 == 0) ? current->pixels[i]
+                                    : led_anim_blend(current->pixels[i], next->pixels[i], t256);
+        if (c.r != out[i].r || c.g != out[i].g || c.b != out[i].b) {
+            out[i] = c;
+            changed = true;
+        }
+    }
+    return changed;
+}
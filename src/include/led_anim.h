@@ -0,0 +1,40 @@
+#ifndef LED_ANIM_H
+#define LED_ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "led_color.h"
+
+// Sequenciador de animações por quadros-chave para LEDs endereçáveis.
+//
+// Cada quadro-chave é uma imagem completa em led_color_t, fica parado por
+// `hold_ms` e depois se funde linearmente no seguinte ao longo de `fade_ms`.
+// Quem chama avança o relógio em passos (led_anim_step), normalmente a uma
+// taxa fixa; o quadro resultante é escrito sobre o anterior e comparado pixel a
+// pixel com ele, de modo que passos sem mudança visível não geram envio à fita.
+// Sequências com um único quadro-chave, ou sem repetição e já no último, ficam
+// paradas e não precisam de passos. Não depende do Pico SDK nem do FreeRTOS.
+
+typedef struct {
+    const led_color_t *pixels; // Imagem com `pixel_count` posições (ver led_anim_start)
+    uint16_t hold_ms;          // Tempo parado neste quadro-chave
+    uint16_t fade_ms;          // Transição cruzada para o próximo (0 = corte seco)
+} led_anim_keyframe_t;
+
+typedef struct {
+    const led_anim_keyframe_t *frames;
+    uint8_t count;
+    uint8_t index;        // Quadro-chave atual
+    uint16_t pixel_count;
+    uint32_t elapsed_ms;  // Tempo desde o início do quadro-chave atual
+    bool loop;            // Volta ao primeiro depois do último
+} led_anim_t;
+
+void led_anim_start(led_anim_t *anim, const led_anim_keyframe_t *frames, uint8_t count,
+                    uint16_t pixel_count, bool loop);
+bool led_anim_step(led_anim_t *anim, uint32_t dt_ms, led_color_t *out);
+bool led_anim_running(const led_anim_t *anim);
+led_color_t led_anim_blend(led_color_t a, led_color_t b, uint16_t t256);
+
+#endif // LED_ANIM_H
@@ -0,0 +1,40 @@
+#ifndef LED_COLOR_H
+#define LED_COLOR_H
+
+#include <stdint.h>
+
+// Cores de LEDs endereçáveis em RGB de 8 bits por canal.
+//
+// A conversão para a palavra GRB do WS2812 não usa ponto flutuante: uma tabela de
+// 256 posições combina a correção de gama (2,2) com o brilho global e só é
+// recalculada quando o brilho muda. Converter um pixel custa três leituras da
+// tabela e três deslocamentos. Não depende do Pico SDK: roda no host para testes
+// e benchmarks.
+
+#define LED_COLOR_GAMMA_X10 22 // Gama usada para gerar led_color_gamma8 em led_color.c
+
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} led_color_t;
+
+// Nível de saída por valor de canal, já com gama e brilho aplicados
+typedef struct {
+    uint8_t level[256];
+    uint8_t brightness; // Brilho com que a tabela foi montada (0-255)
+} led_color_lut_t;
+
+void led_color_lut_build(led_color_lut_t *lut, uint8_t brightness);
+
+/**
+ * @brief Converte uma cor para a palavra enviada à PIO: G nos bits 31-24,
+ *        R nos bits 23-16 e B nos bits 15-8.
+ */
+static inline uint32_t led_color_to_grb(const led_color_lut_t *lut, led_color_t color) {
+    return ((uint32_t)lut->level[color.g] << 24) |
+           ((uint32_t)lut->level[color.r] << 16) |
+           ((uint32_t)lut->level[color.b] << 8);
+}
+
+#endif // LED_COLOR_H
@@ -0,0 +1,77 @@
+#include "led_layout.h"
+
+/**
+ * @brief Número de LEDs da saída.
+ */
+uint16_t led_layout_count(const led_layout_t *layout) {
+    return (uint16_t)(layout->width * layout->height);
+}
+
+/**
+ * @brief Posição na fita do LED na coluna `x` e linha `y` (origem no canto superior esquerdo).
+ *
+ * @return Índice do LED, ou LED_LAYOUT_NONE se (x, y) estiver fora da saída.
+ */
+uint16_t led_layout_index(const led_layout_t *layout, uint16_t x, uint16_t y) {
+    if (x >= layout->width || y >= layout->height) {
+        return LED_LAYOUT_NONE;
+    }
+    if (layout->map != NULL) {
+        return layout->map[y * layout->width + x];
+    }
+
+    uint16_t col = (layout->flags & LED_LAYOUT_ORIGIN_RIGHT) ? (uint16_t)(layout->width - 1 - x) : x;
+    uint16_t row = (layout->flags & LED_LAYOUT_ORIGIN_BOTTOM) ? (uint16_t)(layout->height - 1 - y) : y;
+
+    // A fita percorre `major` segmentos de `run` LEDs cada
+    uint16_t major, minor, run;
+    if (layout->flags & LED_LAYOUT_COLUMNS) {
+        major = col;
+        minor = row;
+        run = layout->height;
+    } else {
+        major = row;
+        minor = col;
+        run = layout->width;
+    }
+    if ((layout->flags & LED_LAYOUT_SERPENTINE) && (major & 1u)) {
+        minor = (uint16_t)(run - 1 - minor);
+    }
+    return (uint16_t)(major * run + minor);
+}
+
+/**
+ * @brief Preenche a tabela de posições de todos os LEDs (y * width + x), para
+ *        saídas grandes que desenham muitos pixels por quadro.
+ *
+ * @param map Destino com led_layout_count() posições.
+ */
+void led_layout_build_map(const led_layout_t *layout, uint16_t *map) {
+    for (uint16_t y = 0; y < layout->height; ++y) {
+        for (uint16_t x = 0; x < layout->width; ++x) {
+            map[y * layout->width + x] = led_layout_index(layout, x, y);
+        }
+    }
+}
+
+/**
+ * @brief Verifica se cada LED da fita corresponde a exatamente uma coordenada
+ *        (útil para validar tabelas explícitas). Suporta até 1024 LEDs.
+ */
+bool led_layout_is_bijective(const led_layout_t *layout) {
+    uint32_t seen[1024 / 32] = {0};
+    uint16_t count = led_layout_count(layout);
+    if (count > 1024) {
+        return false;
+    }
+    for (uint16_t y = 0; y < layout->height; ++y) {
+        for (uint16_t x = 0; x < layout->width; ++x) {
+            uint16_t index = led_layout_index(layout, x, y);
+            if (index >= count || (seen[index / 32] & (1u << (index % 32)))) {
+                return false;
+            }
+            seen[index / 32] |= 1u << (index % 32);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+#ifndef LED_LAYOUT_H
+#define LED_LAYOUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Geometria de uma saída de LEDs endereçáveis: converte coordenadas (x, y), com
+// a origem no canto superior esquerdo como em uma imagem, na posição do LED na
+// fita. Cobre fitas lineares (altura 1) e painéis montados em linhas ou colunas,
+// progressivos ou em serpentina, com o LED 0 em qualquer canto. Montagens
+// irregulares usam uma tabela explícita (`map`). Não depende do Pico SDK: a
+// geometria de cada saída pode ser verificada no host.
+
+#define LED_LAYOUT_ORIGIN_RIGHT  (1u << 0) // LED 0 na coluna da direita
+#define LED_LAYOUT_ORIGIN_BOTTOM (1u << 1) // LED 0 na linha de baixo
+#define LED_LAYOUT_COLUMNS       (1u << 2) // A fita percorre colunas (senão, linhas)
+#define LED_LAYOUT_SERPENTINE    (1u << 3) // Linhas (ou colunas) alternam o sentido
+
+#define LED_LAYOUT_NONE 0xFFFFu // Coordenada fora da saída
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t flags;       // LED_LAYOUT_*; ignorado se `map` for usado
+    const uint16_t *map; // Opcional: posição na fita de cada (x, y), em y * width + x
+} led_layout_t;
+
+uint16_t led_layout_count(const led_layout_t *layout);
+uint16_t led_layout_index(const led_layout_t *layout, uint16_t x, uint16_t y);
+void led_layout_build_map(const led_layout_t *layout, uint16_t *map);
+bool led_layout_is_bijective(const led_layout_t *layout);
+
+#endif // LED_LAYOUT_H
@@ -2,209 +2,381 @@
 #include "config.h"
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
-#include "hardware/clocks.h"
-#include "led_matrix.pio.h" // Certifique-se que este nome está correto
+#include "led_strip.h"
+#include "led_color.h"
+#include "led_anim.h"
+#include "matrix_bitmap.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
-#include <math.h>   // For fmaxf, fminf
 #include <string.h> // For memset
 
 // --- Internal Definitions ---
-static PIO pio_instance = MATRIX_PIO_INSTANCE;
-static uint pio_sm = MATRIX_PIO_SM;
-static uint32_t pixel_buffer[MATRIX_SIZE];
-
-#define MATRIX_GLOBAL_BRIGHTNESS 0.15f
-
+// Quadro em desenho, na ordem de uma imagem (y * MATRIX_DIM + x); a ordem da fita
+// vem de matrix_layout em led_strip_show()
+static led_color_t pixel_buffer[MATRIX_SIZE];
+
+// Saída da matriz: 5x5 em serpentina, LED 0 no canto inferior direito
+static const led_layout_t matrix_layout = {
+    MATRIX_DIM, MATRIX_DIM, LED_LAYOUT_ORIGIN_RIGHT | LED_LAYOUT_ORIGIN_BOTTOM | LED_LAYOUT_SERPENTINE, NULL };
+static uint16_t matrix_map[MATRIX_SIZE];
+static led_strip_t matrix_strip;
+static bool matrix_strip_ready = false;
+
+// Quadro convertido para GRB e lido pelo DMA: o próximo quadro pode ser desenhado
+// em pixel_buffer durante o envio
+static uint32_t tx_buffer[MATRIX_SIZE];
+static led_color_lut_t matrix_lut;
+static volatile uint8_t matrix_brightness = MATRIX_BRIGHTNESS; // Pedido; a tabela segue no próximo quadro
+static bool matrix_tx_pending = false;
+static uint32_t matrix_tx_timeouts = 0;
+
+// Cena em exibição: só é reconstruída quando o que a matriz deve mostrar muda
 typedef struct {
-    float r;
-    float g;
-    float b;
-} ws2812b_color_t;
-
-static const ws2812b_color_t COLOR_BLACK       = {0.0f, 0.0f, 0.0f};
-static const ws2812b_color_t COLOR_RED_ALERT   = {1.0f, 0.0f, 0.0f};
-static const ws2812b_color_t COLOR_YELLOW_WATER= {0.8f, 0.8f, 0.0f};
-static const ws2812b_color_t COLOR_BLUE_RAIN   = {0.0f, 0.3f, 1.0f};
-static const ws2812b_color_t COLOR_ORANGE_BOTH = {1.0f, 0.4f, 0.0f};
-static const ws2812b_color_t COLOR_GREEN_NORMAL= {0.0f, 1.0f, 0.0f};
-static const ws2812b_color_t COLOR_CYAN_WATER_LEVEL = {0.0f, 0.7f, 0.7f};
-
-static const uint8_t Leds_Matrix_position[MATRIX_DIM][MATRIX_DIM] = {
-    {24, 23, 22, 21, 20},
-    {15, 16, 17, 18, 19},
-    {14, 13, 12, 11, 10},
-    { 5,  6,  7,  8,  9 },
-    { 4,  3,  2,  1,  0 }
-};
+    uint8_t level;      // AlertLevel_t
+    uint8_t water_rows; // Linhas de água (só ALERT_WATER_HIGH)
+    bool alert_active;
+} matrix_scene_t;
+
+static matrix_scene_t matrix_scene;
+static bool matrix_scene_valid = false;
+static led_color_t keyframe_pixels[MATRIX_ANIM_MAX_KEYFRAMES][MATRIX_SIZE];
+static led_anim_keyframe_t keyframes[MATRIX_ANIM_MAX_KEYFRAMES];
+static uint8_t keyframe_count = 0;
+static led_anim_t matrix_anim;
+static uint32_t matrix_step_us = 0;   // Instante do último passo (avança em ms inteiros)
+static bool matrix_step_timed = false; // O último passo foi de uma animação: o próximo intervalo conta
+static bool matrix_dirty = false;      // pixel_buffer ainda não chegou à matriz
+static led_matrix_anim_stats_t matrix_stats;
+
+// Cores em intensidade percebida; gama e brilho ficam na tabela (led_color.h)
+static const led_color_t COLOR_BLACK       = {  0,   0,   0};
+static const led_color_t COLOR_RED_ALERT   = {255,   0,   0};
+static const led_color_t COLOR_YELLOW_WATER= {204, 204,   0};
+static const led_color_t COLOR_BLUE_RAIN   = {  0,  77, 255};
+static const led_color_t COLOR_ORANGE_BOTH = {255, 102,   0};
+static const led_color_t COLOR_GREEN_NORMAL= {  0, 255,   0};
+static const led_color_t COLOR_CYAN_WATER_LEVEL = {  0, 179, 179};
 
 // --- Frames de Alerta Definidos ---
-
-
-static const char FRAME_RAIN[MATRIX_DIM][MATRIX_DIM + 1] = { // +1 para o terminador nulo '\0'
-    "01010",
-    "00100",
-    "10101",
-    "01010",
-    "00100"
-};
-
-static const char FRAME_BOTH_ALERT[MATRIX_DIM][MATRIX_DIM + 1] = {
-    "01010", // Chuva em cima
-    "10101", // Chuva em cima
-    "00100", // "Raio" ou separador
-    "11111", // Nível água
-    "11111"  // Nível água
+// Arte ASCII compilada em máscaras na ordem da imagem (matrix_bitmap.h)
+_Static_assert(MATRIX_DIM == 5 && MATRIX_SIZE == 25, "matrix_bitmap.h descreve uma matriz 5x5");
+
+#define ICON_RAIN          0b01010, \
+                           0b00100, \
+                           0b10101, \
+                           0b01010, \
+                           0b00100
+
+#define ICON_BOTH_ALERT    0b01010, /* Chuva em cima */ \
+                           0b10101, /* Chuva em cima */ \
+                           0b00100, /* "Raio" ou separador */ \
+                           0b11111, /* Nível água */ \
+                           0b11111  /* Nível água */
+
+#define ICON_RAPID_RISE    0b00100, /* Seta para cima */ \
+                           0b01110, \
+                           0b10101, \
+                           0b00100, \
+                           0b00100
+
+#define ICON_NORMAL_STATUS 0b00000, \
+                           0b00001, \
+                           0b00010, \
+                           0b10100, \
+                           0b01000
+
+#define ICON_UNKNOWN       0b10001, \
+                           0b01010, \
+                           0b00100, \
+                           0b01010, \
+                           0b10001
+
+static const uint32_t FRAME_BOTH_ALERT = MATRIX_FRAME(ICON_BOTH_ALERT);
+static const uint32_t FRAME_NORMAL_STATUS = MATRIX_FRAME(ICON_NORMAL_STATUS);
+static const uint32_t FRAME_UNKNOWN = MATRIX_FRAME(ICON_UNKNOWN);
+
+// Gotas caindo: o padrão desce uma linha por quadro-chave
+static const uint32_t FRAMES_RAIN[MATRIX_DIM] = {
+    MATRIX_FRAME(ICON_RAIN),
+    MATRIX_FRAME(MATRIX_ROLL_DOWN(ICON_RAIN)),
+    MATRIX_FRAME(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(ICON_RAIN))),
+    MATRIX_FRAME(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(ICON_RAIN)))),
+    MATRIX_FRAME(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(MATRIX_ROLL_DOWN(ICON_RAIN))))),
 };
 
-static const char FRAME_NORMAL_STATUS[MATRIX_DIM][MATRIX_DIM + 1] = {
-    "00000",
-    "00001",
-    "00010",
-    "10100",
-    "01000"
+// Seta subindo: o padrão sobe uma linha por quadro-chave
+static const uint32_t FRAMES_RAPID_RISE[MATRIX_DIM] = {
+    MATRIX_FRAME(ICON_RAPID_RISE),
+    MATRIX_FRAME(MATRIX_ROLL_UP(ICON_RAPID_RISE)),
+    MATRIX_FRAME(MATRIX_ROLL_UP(MATRIX_ROLL_UP(ICON_RAPID_RISE))),
+    MATRIX_FRAME(MATRIX_ROLL_UP(MATRIX_ROLL_UP(MATRIX_ROLL_UP(ICON_RAPID_RISE)))),
+    MATRIX_FRAME(MATRIX_ROLL_UP(MATRIX_ROLL_UP(MATRIX_ROLL_UP(MATRIX_ROLL_UP(ICON_RAPID_RISE))))),
 };
 
 
 // --- Static Helper Functions ---
-static inline int get_pixel_index(int row, int col) {
-    // row e col são 0-based aqui para alinhar com arrays C
-    if (row >= 0 && row < MATRIX_DIM && col >= 0 && col < MATRIX_DIM) {
-        return Leds_Matrix_position[row][col];
-    }
-    return -1;
+// Callback do envio (contexto de interrupção): o quadro travou, acorda a tarefa que o enviou
+static void matrix_tx_done(void *ctx) {
+    BaseType_t higher_priority_woken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)ctx, MATRIX_TX_NOTIFY_INDEX, &higher_priority_woken);
+    portYIELD_FROM_ISR(higher_priority_woken);
 }
 
-static inline uint32_t color_to_pio_grb_format(ws2812b_color_t color, float brightness) {
-    brightness = fmaxf(0.0f, fminf(1.0f, brightness));
-    float r = fmaxf(0.0f, fminf(1.0f, color.r * brightness));
-    float g = fmaxf(0.0f, fminf(1.0f, color.g * brightness));
-    float b = fmaxf(0.0f, fminf(1.0f, color.b * brightness));
+// Inicia o envio de pixel_buffer sem bloquear o núcleo (com DMA), remontando a tabela
+// de cores se o brilho mudou. Deve ser chamada por uma tarefa.
+// Retorna false se o quadro foi descartado.
+static bool matrix_render() {
+    if (!matrix_strip_ready) {
+        return false;
+    }
+    if (!led_matrix_wait_rendered(pdMS_TO_TICKS(MATRIX_TX_TIMEOUT_MS))) {
+        matrix_tx_timeouts++;
+        return false; // O envio anterior ainda usa tx_buffer: este quadro é descartado
+    }
 
-    uint8_t R_val = (uint8_t)(r * 255.0f + 0.3f);
-    uint8_t G_val = (uint8_t)(g * 255.0f + 0.3f);
-    uint8_t B_val = (uint8_t)(b * 255.0f + 0.3f);
+    uint8_t brightness = matrix_brightness;
+    if (brightness != matrix_lut.brightness) {
+        led_color_lut_build(&matrix_lut, brightness);
+    }
+    bool started = led_strip_show(&matrix_strip, pixel_buffer, &matrix_lut, matrix_tx_done, xTaskGetCurrentTaskHandle());
+    // Sem DMA o envio já terminou e não haverá notificação
+    matrix_tx_pending = started && matrix_strip.dma_ready;
+    return started;
+}
 
-    return ((uint32_t)(G_val) << 24) | ((uint32_t)(R_val) << 16) | ((uint32_t)(B_val) << 8);
+// Acrescenta um quadro-chave apagado à cena em construção e devolve sua imagem
+static led_color_t *add_keyframe(uint16_t hold_ms, uint16_t fade_ms) {
+    led_color_t *pixels = keyframe_pixels[keyframe_count];
+    memset(pixels, 0, sizeof(keyframe_pixels[0]));
+    keyframes[keyframe_count].pixels = pixels;
+    keyframes[keyframe_count].hold_ms = hold_ms;
+    keyframes[keyframe_count].fade_ms = fade_ms;
+    keyframe_count++;
+    return pixels;
 }
 
-static void matrix_render() {
-    for (int i = 0; i < MATRIX_SIZE; ++i) {
-        pio_sm_put_blocking(pio_instance, pio_sm, pixel_buffer[i]);
+// Monta os quadros-chave da cena e reinicia a animação no primeiro deles
+static void matrix_build_scene(const matrix_scene_t *scene) {
+    keyframe_count = 0;
+
+    if (!scene->alert_active || scene->level == ALERT_NONE) {
+        matrix_bitmap_fill(add_keyframe(0, 0), FRAME_NORMAL_STATUS, COLOR_GREEN_NORMAL);
+    } else {
+        switch (scene->level) {
+            case ALERT_RAIN_HIGH:
+                for (int k = 0; k < MATRIX_DIM; ++k) {
+                    matrix_bitmap_fill(add_keyframe(MATRIX_ANIM_RAIN_HOLD_MS, MATRIX_ANIM_RAIN_FADE_MS),
+                                       FRAMES_RAIN[k], COLOR_BLUE_RAIN);
+                }
+                break;
+
+            case ALERT_WATER_HIGH:
+                // Água subindo até o nível atual, que fica parado antes de recomeçar
+                for (int rows = 1; rows <= scene->water_rows; ++rows) {
+                    bool top = (rows == scene->water_rows);
+                    matrix_bitmap_fill(add_keyframe(top ? MATRIX_ANIM_WATER_TOP_HOLD_MS : MATRIX_ANIM_WATER_HOLD_MS,
+                                                    MATRIX_ANIM_WATER_FADE_MS),
+                                       MATRIX_BOTTOM_ROWS(rows), COLOR_CYAN_WATER_LEVEL);
+                }
+                if (keyframe_count == 0) {
+                    add_keyframe(0, 0); // Nível abaixo de uma linha: matriz apagada
+                }
+                break;
+
+            case ALERT_BOTH_HIGH:
+                // Pulsa entre laranja e vermelho
+                matrix_bitmap_fill(add_keyframe(MATRIX_ANIM_PULSE_HOLD_MS, MATRIX_ANIM_PULSE_FADE_MS),
+                                   FRAME_BOTH_ALERT, COLOR_ORANGE_BOTH);
+                matrix_bitmap_fill(add_keyframe(MATRIX_ANIM_PULSE_HOLD_MS, MATRIX_ANIM_PULSE_FADE_MS),
+                                   FRAME_BOTH_ALERT, COLOR_RED_ALERT);
+                break;
+
+            case ALERT_RAPID_RISE:
+                for (int k = 0; k < MATRIX_DIM; ++k) {
+                    matrix_bitmap_fill(add_keyframe(MATRIX_ANIM_RISE_HOLD_MS, MATRIX_ANIM_RISE_FADE_MS),
+                                       FRAMES_RAPID_RISE[k], COLOR_YELLOW_WATER);
+                }
+                break;
+
+            default:
+                // Caso desconhecido: 'X' vermelho
+                matrix_bitmap_fill(add_keyframe(0, 0), FRAME_UNKNOWN, COLOR_RED_ALERT);
+                break;
+        }
     }
-    busy_wait_us(50); // Para WS2812B, um delay de reset maior pode ser necessário (>50us, alguns recomendam 300us)
-                      // mas o datasheet do SK6812 (similar) especifica >80us para reset.
-                      // Se estiver usando SK6812 (comum nas matrizes do Pico), 50us pode ser pouco. Tente 100us ou 300us se tiver problemas.
+
+    led_anim_start(&matrix_anim, keyframes, keyframe_count, MATRIX_SIZE, true);
+    matrix_step_us = time_us_32();
+    matrix_step_timed = false;
 }
 
-// Set a pixel in the buffer usando row/col 0-based
-static void led_activate_position_internal(int row, int col, ws2812b_color_t color, float brightness_mod) {
-    int index = get_pixel_index(row, col);
-    if (index != -1) {
-        pixel_buffer[index] = color_to_pio_grb_format(color, MATRIX_GLOBAL_BRIGHTNESS * brightness_mod);
+// Troca a cena se ela mudou; uma cena igual à atual continua a animação de onde está
+static void matrix_set_scene(const matrix_scene_t *scene) {
+    if (matrix_scene_valid && memcmp(scene, &matrix_scene, sizeof(*scene)) == 0) {
+        return;
     }
-}
-// Sobrecarga com brilho padrão
-static void led_activate_position(int row, int col, ws2812b_color_t color) {
-    led_activate_position_internal(row, col, color, 1.0f);
+    matrix_scene = *scene;
+    matrix_scene_valid = true;
+    matrix_build_scene(scene);
 }
 
 
 // --- Public API Functions ---
 
 void led_matrix_init() {
-    uint offset = pio_add_program(pio_instance, &led_matrix_program); // Use o nome correto do programa .pio
-    led_matrix_program_init(pio_instance, pio_sm, offset, MATRIX_WS2812_PIN); // Use o nome correto da função init
+    matrix_strip_ready = led_strip_init(&matrix_strip, MATRIX_PIO_INSTANCE, MATRIX_WS2812_PIN, &matrix_layout,
+                                        matrix_map, tx_buffer, MATRIX_RESET_US);
+    led_color_lut_build(&matrix_lut, matrix_brightness);
     led_matrix_clear(); // Limpa a matriz na inicialização
-    printf("LED Matrix Initialized (Pin: %d, PIO: %d, SM: %d)\n", MATRIX_WS2812_PIN, pio_get_index(pio_instance), pio_sm);
+    matrix_scene_valid = false;
+    if (!matrix_strip_ready) {
+        printf("LED Matrix: sem maquina de estados livre na PIO %d\n", pio_get_index(MATRIX_PIO_INSTANCE));
+        return;
+    }
+    printf("LED Matrix Initialized (Pin: %d, PIO: %d, SM: %d, DMA: %s, quadro %lu us)\n", MATRIX_WS2812_PIN,
+           pio_get_index(matrix_strip.pio), matrix_strip.sm, matrix_strip.dma_ready ? "sim" : "nao",
+           (unsigned long)led_strip_frame_us(&matrix_strip));
+}
+
+/**
+ * @brief Aguarda o fim do envio iniciado pelo último quadro (incluindo o tempo de
+ *        reset), dormindo na notificação MATRIX_TX_NOTIFY_INDEX. Deve ser chamada
+ *        pela mesma tarefa que desenhou o quadro.
+ *
+ * @return true se não há envio pendente; false em caso de timeout.
+ */
+bool led_matrix_wait_rendered(TickType_t timeout) {
+    if (!matrix_tx_pending) {
+        return true;
+    }
+    if (ulTaskNotifyTakeIndexed(MATRIX_TX_NOTIFY_INDEX, pdTRUE, timeout) == 0) {
+        return false;
+    }
+    matrix_tx_pending = false;
+    return true;
+}
+
+/**
+ * @brief Ajusta o brilho global (ex.: modo noturno). Pode ser chamada de qualquer
+ *        tarefa ou interrupção; a tabela de gama e brilho é remontada pela tarefa da
+ *        matriz no próximo quadro, e os quadros seguintes só a consultam.
+ *
+ * @param brightness 0 = apagado, 255 = intensidade máxima.
+ */
+void led_matrix_set_brightness(uint8_t brightness) {
+    matrix_brightness = brightness;
+}
+
+uint8_t led_matrix_get_brightness(void) {
+    return matrix_brightness;
+}
+
+/**
+ * @brief Quadros descartados porque o envio anterior não terminou a tempo (desde o boot).
+ */
+uint32_t led_matrix_render_timeouts(void) {
+    return matrix_tx_timeouts;
 }
 
 void led_matrix_clear() {
-    uint32_t pio_black = color_to_pio_grb_format(COLOR_BLACK, 1.0f);
     for (int i = 0; i < MATRIX_SIZE; ++i) {
-        pixel_buffer[i] = pio_black;
+        pixel_buffer[i] = COLOR_BLACK;
     }
     // Não renderize aqui, deixe as funções de display fazerem o render
 }
 
-// Função auxiliar para desenhar um frame a partir de um array de char
-static void draw_frame(const char frame[MATRIX_DIM][MATRIX_DIM + 1], ws2812b_color_t color) {
-    for (int r = 0; r < MATRIX_DIM; ++r) {
-        for (int c = 0; c < MATRIX_DIM; ++c) {
-            if (frame[r][c] == '1') {
-                led_activate_position(r, c, color);
-            }
-        }
+/**
+ * @brief Mostra o ícone de status normal. O envio à matriz é feito por led_matrix_update().
+ */
+void led_matrix_display_normal_status() {
+    matrix_scene_t scene;
+    memset(&scene, 0, sizeof(scene));
+    scene.level = ALERT_NONE;
+    matrix_set_scene(&scene);
+}
+
+/**
+ * @brief Seleciona a animação do alerta. Se a cena resultante for a mesma em
+ *        exibição (ex.: a água variou dentro da mesma linha), a animação segue
+ *        sem reiniciar. O envio à matriz é feito por led_matrix_update().
+ */
+void led_matrix_display_alert(AlertLevel_t level, uint8_t water_percent, uint8_t rain_percent) {
+    (void)rain_percent; // A animação de chuva não depende da intensidade
+    matrix_scene_t scene;
+    memset(&scene, 0, sizeof(scene));
+    scene.level = (uint8_t)level;
+    scene.alert_active = (level != ALERT_NONE);
+    if (level == ALERT_WATER_HIGH) {
+        scene.water_rows = led_matrix_water_rows(water_percent);
     }
+    matrix_set_scene(&scene);
 }
 
-void led_matrix_display_normal_status() {
-    led_matrix_clear(); // Limpa antes de desenhar
-    draw_frame(FRAME_NORMAL_STATUS, COLOR_GREEN_NORMAL);
-    matrix_render();
+/**
+ * @brief Linhas de água acesas no alerta de nível alto (degraus de 100/MATRIX_DIM %).
+ *        Também usada pelo filtro de despacho da matriz (main.c), para que só uma
+ *        troca de degrau acorde a tarefa.
+ */
+uint8_t led_matrix_water_rows(uint8_t water_percent) {
+    int water_rows = (water_percent * MATRIX_DIM) / 100;
+    if (water_rows > MATRIX_DIM) water_rows = MATRIX_DIM;
+    return (uint8_t)water_rows;
 }
 
-void led_matrix_display_alert(AlertLevel_t level, uint8_t water_percent, uint8_t rain_percent) {
-    led_matrix_clear(); // Limpa antes de desenhar o novo estado
-
-    switch (level) {
-        case ALERT_NONE:
-            led_matrix_display_normal_status(); // Reusa a função normal
-            break;
-
-        case ALERT_RAIN_HIGH:
-            draw_frame(FRAME_RAIN, COLOR_BLUE_RAIN);
-            // Poderia adicionar uma indicação da intensidade da chuva aqui se quisesse
-            // Por exemplo, preenchendo algumas colunas da direita com base em rain_percent
-            // Mas para simplificar, usamos apenas o frame estático para "chuva alta".
-            break;
-
-        case ALERT_WATER_HIGH:
-            { // Bloco para variáveis locais
-                int water_rows_to_light = (water_percent * MATRIX_DIM) / 100;
-                // Garante que o valor esteja entre 0 e MATRIX_DIM
-                if (water_rows_to_light < 0) water_rows_to_light = 0;
-                if (water_rows_to_light > MATRIX_DIM) water_rows_to_light = MATRIX_DIM;
-
-                for (int r = 0; r < MATRIX_DIM; ++r) {
-                    // Preenche de baixo para cima
-                    if (r >= (MATRIX_DIM - water_rows_to_light)) {
-                        for (int c = 0; c < MATRIX_DIM; ++c) {
-                            led_activate_position(r, c, COLOR_CYAN_WATER_LEVEL);
-                        }
-                    }
-                }
-            }
-            break;
-
-        case ALERT_BOTH_HIGH:
-            // Combina o frame de alerta ambos com a cor laranja
-            // ou você pode ter lógica mais complexa aqui.
-            // Para o seu FRAME_BOTH_ALERT:
-            for (int r = 0; r < MATRIX_DIM; ++r) {
-                for (int c = 0; c < MATRIX_DIM; ++c) {
-                    if (FRAME_BOTH_ALERT[r][c] == '1') {
-                        // Colorir a parte da chuva e a parte da água com cores diferentes?
-                        if (r < 3) { // Primeiras 3 linhas (chuva/raio)
-                            led_activate_position(r, c, COLOR_BLUE_RAIN); // Ou laranja para mais perigo
-                        } else { // Últimas 2 linhas (água)
-                            led_activate_position(r, c, COLOR_CYAN_WATER_LEVEL); // Ou laranja
-                        }
-                        led_activate_position(r, c, COLOR_ORANGE_BOTH);
-                    }
-                }
-            }
-            // Se você quer que FRAME_BOTH_ALERT use uma cor única de perigo:
-            // draw_frame(FRAME_BOTH_ALERT, COLOR_ORANGE_BOTH);
-            break;
-
-        default:
-            // Caso desconhecido, talvez mostrar um 'X' vermelho ou limpar
-            for(int i=0; i < MATRIX_DIM; ++i) {
-                led_activate_position(i, i, COLOR_RED_ALERT);
-                led_activate_position(i, MATRIX_DIM - 1 - i, COLOR_RED_ALERT);
-            }
-            break;
+/**
+ * @brief Avança a animação até o instante atual e envia o quadro à matriz se algum
+ *        pixel mudou (ou se o brilho mudou). Deve ser chamada pela tarefa da matriz,
+ *        a cada passo do timer de animação e após led_matrix_display_*().
+ *
+ * @return true se um quadro foi enviado.
+ */
+bool led_matrix_update(void) {
+    uint32_t start_us = time_us_32();
+    uint32_t interval_us = start_us - matrix_step_us;
+    if (matrix_step_timed && interval_us > matrix_stats.interval_us_max) {
+        matrix_stats.interval_us_max = interval_us;
+    }
+    uint32_t dt_ms = interval_us / 1000;
+    matrix_step_us += dt_ms * 1000; // O resto em us fica para o próximo passo
+
+    if (led_anim_step(&matrix_anim, dt_ms, pixel_buffer) || matrix_brightness != matrix_lut.brightness) {
+        matrix_dirty = true;
+    }
+    bool pushed = false;
+    if (matrix_dirty) {
+        pushed = matrix_render();
+        matrix_dirty = !pushed; // Quadro descartado: tenta de novo no próximo passo
+        if (pushed) {
+            matrix_stats.pushed++;
+        }
+    } else {
+        matrix_stats.skipped++;
     }
+    matrix_step_timed = led_anim_running(&matrix_anim);
 
-    matrix_render(); // Renderiza o frame final
-}
\ No newline at end of file
+    uint32_t elapsed_us = time_us_32() - start_us;
+    matrix_stats.steps++;
+    matrix_stats.update_us_total += elapsed_us;
+    if (elapsed_us > matrix_stats.update_us_max) {
+        matrix_stats.update_us_max = elapsed_us;
+    }
+    return pushed;
+}
+
+/**
+ * @brief Indica se a cena atual é animada (o timer de animação deve rodar).
+ */
+bool led_matrix_animating(void) {
+    return led_anim_running(&matrix_anim);
+}
+
+/**
+ * @brief Estatísticas de animação e envio desde o boot. Só leitura: os contadores
+ *        têm um único escritor (a tarefa da matriz), então não há reset daqui.
+ *
+ * @param out Destino.
+ */
+void led_matrix_get_anim_stats(led_matrix_anim_stats_t *out) {
+    *out = matrix_stats;
+}
@@ -4,10 +4,34 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "config.h"
+#include "FreeRTOS.h"
+
+// A matriz mostra cenas animadas por quadros-chave (led_anim.h). As funções
+// led_matrix_display_*() só escolhem a cena; led_matrix_update() avança a
+// animação e envia o quadro quando algum pixel mudou.
+
+// Contadores desde o boot, escritos só pela tarefa da matriz (led_matrix_update()).
+// Quem lê de outro núcleo não zera nada: calcula a diferença entre duas leituras.
+typedef struct {
+    uint32_t steps;           // Chamadas a led_matrix_update()
+    uint32_t pushed;          // Quadros enviados à matriz
+    uint32_t skipped;         // Passos sem mudança visível (nada enviado)
+    uint32_t update_us_total; // CPU acumulada em led_matrix_update()
+    uint32_t update_us_max;   // Pior passo desde o boot
+    uint32_t interval_us_max; // Maior intervalo entre passos de uma animação, desde o boot
+} led_matrix_anim_stats_t;
 
 void led_matrix_init();
 void led_matrix_clear();
 void led_matrix_display_alert(AlertLevel_t level, uint8_t water_percent, uint8_t rain_percent);
+uint8_t led_matrix_water_rows(uint8_t water_percent);
 void led_matrix_display_normal_status();
+bool led_matrix_update(void);
+bool led_matrix_animating(void);
+void led_matrix_get_anim_stats(led_matrix_anim_stats_t *out);
+bool led_matrix_wait_rendered(TickType_t timeout);
+uint32_t led_matrix_render_timeouts(void);
+void led_matrix_set_brightness(uint8_t brightness);
+uint8_t led_matrix_get_brightness(void);
 
 #endif // LED_MATRIX_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "led_strip.h"
+#include "pico/stdlib.h"
+#include "led_matrix.pio.h"
+
+// --- Internal Definitions ---
+// Offset do programa WS2812 em cada PIO (-1 = ainda não carregado): as saídas da
+// mesma PIO compartilham uma cópia
+static int strip_program_offset[2] = { -1, -1 };
+
+// --- Public API Functions ---
+
+/**
+ * @brief Reserva uma máquina de estados livre em `pio`, carrega o programa WS2812
+ *        (uma vez por PIO) com o tempo de bit derivado do clk_sys, reserva um
+ *        canal DMA para a saída e monta a tabela de posições da geometria.
+ *
+ * @param strip Estado da saída (deve permanecer válido, normalmente estático).
+ * @param pio Instância da PIO.
+ * @param pin GPIO de dados da fita.
+ * @param layout Geometria; o número de LEDs é width * height.
+ * @param map Buffer de led_layout_count(layout) posições para a tabela; pode ser NULL
+ *            se `layout` já trouxer a sua (`layout->map`).
+ * @param tx Buffer de led_layout_count(layout) palavras, válido enquanto a saída existir.
+ * @param reset_us Tempo de linha baixa que trava as cores após cada quadro.
+ * @return false se não houver máquina de estados livre ou espaço para o programa.
+ */
+bool led_strip_init(led_strip_t *strip, PIO pio, uint pin, const led_layout_t *layout,
+                    uint16_t *map, uint32_t *tx, uint32_t reset_us) {
+    if (layout->map == NULL && map == NULL) {
+        return false;
+    }
+    uint pio_index = pio_get_index(pio);
+    if (strip_program_offset[pio_index] < 0) {
+        if (!pio_can_add_program(pio, &led_matrix_program)) {
+            return false;
+        }
+        strip_program_offset[pio_index] = (int)pio_add_program(pio, &led_matrix_program);
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return false;
+    }
+
+    strip->pio = pio;
+    strip->sm = (uint)sm;
+    strip->pin = pin;
+    strip->layout = *layout;
+    strip->length = led_layout_count(layout);
+    if (layout->map != NULL) {
+        strip->map = layout->map;
+    } else {
+        // Calculada uma vez: cada quadro só consulta a tabela
+        led_layout_build_map(layout, map);
+        strip->map = map;
+    }
+    strip->tx = tx;
+    strip->reset_us = reset_us;
+
+    led_matrix_program_init(pio, (uint)sm, (uint)strip_program_offset[pio_index], pin, WS2812_BIT_HZ);
+    strip->dma_ready = ws2812_dma_init(&strip->dma, pio, (uint)sm, reset_us);
+    return true;
+}
+
+/**
+ * @brief Converte `pixels` para GRB com a tabela `lut`, colocando cada um na sua
+ *        posição da fita (strip->map), e inicia o envio. `pixels` está na ordem de
+ *        uma imagem: o pixel (x, y) em y * width + x, com a origem no canto superior
+ *        esquerdo, qualquer que seja a montagem da fita. Com DMA, retorna imediatamente e `callback` é chamado em contexto
+ *        de interrupção após o reset; sem DMA (strip->dma_ready falso), envia de
+ *        forma bloqueante e não chama `callback`.
+ *
+ * @return false se o envio anterior desta saída ainda estiver em andamento.
+ */
+bool led_strip_show(led_strip_t *strip, const led_color_t *pixels, const led_color_lut_t *lut,
+                    ws2812_dma_callback_t callback, void *ctx) {
+    if (strip->dma_ready && ws2812_dma_busy(&strip->dma)) {
+        return false;
+    }
+    for (uint16_t i = 0; i < strip->length; ++i) {
+        strip->tx[strip->map[i]] = led_color_to_grb(lut, pixels[i]);
+    }
+
+    if (strip->dma_ready) {
+        return ws2812_dma_write(&strip->dma, strip->tx, strip->length, callback, ctx);
+    }
+    for (uint16_t i = 0; i < strip->length; ++i) {
+        pio_sm_put_blocking(strip->pio, strip->sm, strip->tx[i]);
+    }
+    busy_wait_us(strip->reset_us);
+    return true;
+}
+
+/**
+ * @brief Indica se o envio anterior ainda está em andamento.
+ */
+bool led_strip_busy(const led_strip_t *strip) {
+    return strip->dma_ready && ws2812_dma_busy(&strip->dma);
+}
+
+/**
+ * @brief Duração de um quadro no fio (bits + reset), que limita a taxa de quadros da saída.
+ */
+uint32_t led_strip_frame_us(const led_strip_t *strip) {
+    return (uint32_t)strip->length * WS2812_WORD_US + strip->reset_us;
+}
@@ -0,0 +1,38 @@
+#ifndef LED_STRIP_H
+#define LED_STRIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+#include "led_color.h"
+#include "led_layout.h"
+#include "ws2812_dma.h"
+
+// Saída WS2812 independente: um pino, uma máquina de estados da PIO, um canal DMA
+// e a geometria da fita ou do painel ligado a ela (led_layout.h). Várias saídas
+// (ex.: a matriz da placa e um painel de aviso externo por estação) rodam o mesmo
+// programa PIO em máquinas de estados diferentes e transmitem em paralelo, então
+// a taxa de quadros de cada uma depende só do seu próprio comprimento
+// (30 us por LED + reset), não do total de LEDs.
+
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint pin;
+    uint16_t length;     // LEDs na fita (= led_layout_count(&layout))
+    led_layout_t layout;
+    const uint16_t *map; // Posição na fita de cada pixel (y * width + x), montada na inicialização
+    uint32_t *tx;        // `length` palavras GRB lidas pelo DMA; fornecido por quem inicializa
+    uint32_t reset_us;
+    bool dma_ready;      // false = sem canal DMA livre, envio bloqueante
+    ws2812_dma_t dma;
+} led_strip_t;
+
+bool led_strip_init(led_strip_t *strip, PIO pio, uint pin, const led_layout_t *layout,
+                    uint16_t *map, uint32_t *tx, uint32_t reset_us);
+bool led_strip_show(led_strip_t *strip, const led_color_t *pixels, const led_color_lut_t *lut,
+                    ws2812_dma_callback_t callback, void *ctx);
+bool led_strip_busy(const led_strip_t *strip);
+uint32_t led_strip_frame_us(const led_strip_t *strip);
+
+#endif // LED_STRIP_H
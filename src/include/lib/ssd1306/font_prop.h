@@ -0,0 +1,20 @@
+// Fonte proporcional: os mesmos glifos 8x8 de font.h, recortados às colunas acesas.
+// Tabelas geradas varrendo cada glifo de ' ' a '~'; o espaço fica com 3 colunas.
+
+static const uint8_t font_prop_offset[] = { // Primeira coluna acesa de cada glifo
+    0, 3, 1, 0, 0, 0, 0, 1, 2, 2, 0, 1, 2, 1, 3, 0,
+    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 3, 2, 1, 1, 2, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 0,
+    3, 0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1, 3, 1, 0
+};
+
+static const uint8_t font_prop_width[] = { // Colunas acesas de cada glifo
+    3, 2, 5, 7, 7, 7, 7, 3, 4, 4, 8, 6, 3, 6, 2, 7,
+    7, 6, 7, 7, 7, 7, 7, 7, 7, 7, 2, 3, 5, 6, 5, 6,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 6, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 8, 7, 7, 7, 7, 7, 7, 4, 7, 4, 7, 8,
+    3, 7, 7, 7, 7, 7, 6, 7, 7, 4, 7, 7, 4, 7, 7, 7,
+    7, 7, 7, 7, 6, 7, 7, 7, 7, 7, 7, 6, 2, 6, 7
+};
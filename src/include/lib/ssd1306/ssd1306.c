@@ -1,49 +1,183 @@
+#include <string.h>
 #include "ssd1306.h"
+#include "ssd1306_hal.h"
 #include "font.h"
+#include "font_prop.h"
+#include "font_digits.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+const ssd1306_font_t ssd1306_font_8x8 = { font, NULL, NULL, 8, 1, 0, ' ', '~' };
+const ssd1306_font_t ssd1306_font_prop = { font, font_prop_offset, font_prop_width, 8, 1, 1, ' ', '~' };
+const ssd1306_font_t ssd1306_font_digits16 = { font_digits16, NULL, NULL, 16, 2, 0, ' ', '9' };
+
+// Campos comuns aos dois modos de alocação
+static void ssd1306_setup(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-  ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->front_buffer = NULL;
+  ssd->bytes_sent_last = 0;
+  ssd->bytes_sent_total = 0;
+  ssd->frames_sent = 0;
+  ssd->config_us = 0;
+  ssd->window_setup_us_last = 0;
+}
+
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  ssd1306_setup(ssd, width, height, external_vcc, address, i2c);
+  // 3 bytes de folga na frente: com o 0x40 em ram_buffer[0], os dados (ram_buffer + 1)
+  // começam alinhados a 4 bytes e cada coluna vira duas palavras de 32 bits (blitter)
+  ssd->ram_buffer = (uint8_t *)calloc(ssd->bufsize + 3, sizeof(uint8_t)) + 3;
+  ssd->ram_buffer[0] = 0x40;
+  // Maior janela possível: a tela inteira
+  ssd->tx_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->tx_buffer[0] = 0x40;
+  // Pior caso do fluxo DMA: todos os bytes mais uma janela por página
+  ssd->tx_words = calloc(SSD1306_STREAM_WORDS(ssd->width, ssd->pages), sizeof(uint16_t));
+  // A RAM do controlador tem conteúdo indefinido após o reset: o primeiro envio é completo
+  ssd1306_mark_all_dirty(ssd);
+}
+
+/**
+ * @brief Inicializa o display em modo de dois buffers, sem heap: `buffers` (normalmente
+ *        uma variável estática) guarda o back buffer, onde as primitivas desenham, o
+ *        front buffer, com o último quadro apresentado, e os buffers de transmissão.
+ *        As escritas não rastreiam regiões sujas; elas são calculadas por
+ *        ssd1306_present() comparando os dois buffers.
+ *
+ * @return false se a tela for maior que WIDTH x HEIGHT (tamanho de ssd1306_framebuffers_t).
+ */
+bool ssd1306_init_buffered(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address,
+                           i2c_inst_t *i2c, ssd1306_framebuffers_t *buffers) {
+  if (width > WIDTH || height > HEIGHT) {
+    return false;
+  }
+  ssd1306_setup(ssd, width, height, external_vcc, address, i2c);
+  memset(buffers, 0, sizeof(*buffers));
+  // Mesma folga de ssd1306_init: back + 3 guarda o 0x40 e os dados ficam alinhados
+  ssd->ram_buffer = (uint8_t *)buffers->back + 3;
+  ssd->ram_buffer[0] = 0x40;
+  ssd->front_buffer = (uint8_t *)buffers->front;
+  ssd->tx_buffer = buffers->tx;
+  ssd->tx_buffer[0] = 0x40;
+  ssd->tx_words = buffers->words;
+  ssd1306_mark_all_dirty(ssd);
+  return true;
 }
 
+// Estende a região suja da página até a coluna x
+static inline void ssd1306_extend_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x) {
+  if (x < ssd->dirty_x0[page]) ssd->dirty_x0[page] = x;
+  if (x > ssd->dirty_x1[page]) ssd->dirty_x1[page] = x;
+}
+
+// Marca a coluna x da página como alterada por uma escrita. No modo de dois
+// buffers as regiões vêm da comparação em ssd1306_present(), não das escritas
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x) {
+  if (ssd->front_buffer == NULL) ssd1306_extend_dirty(ssd, page, x);
+}
+
+static inline void ssd1306_mark_clean(ssd1306_t *ssd, uint8_t page) {
+  ssd->dirty_x0[page] = 0xFF;
+  ssd->dirty_x1[page] = 0;
+}
+
+static inline bool ssd1306_page_dirty(const ssd1306_t *ssd, uint8_t page) {
+  return ssd->dirty_x0[page] <= ssd->dirty_x1[page];
+}
+
+/**
+ * @brief Força o próximo ssd1306_send_data a reenviar a tela inteira.
+ */
+void ssd1306_mark_all_dirty(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < SSD1306_MAX_PAGES; ++page) {
+    if (page < ssd->pages) {
+      ssd->dirty_x0[page] = 0;
+      ssd->dirty_x1[page] = ssd->width - 1;
+    } else {
+      ssd1306_mark_clean(ssd, page);
+    }
+  }
+}
+
+// Sequência de inicialização: modo de endereçamento vertical (ver ssd1306_send_window)
+static const uint8_t ssd1306_init_sequence[] = {
+  SET_DISP | 0x00,
+  SET_MEM_ADDR, 0x01,
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+  SET_DISP | 0x01,
+};
+
+/**
+ * @brief Envia a sequência de inicialização em uma única transação I2C
+ *        (antes eram 25, uma por comando) e registra a duração em config_us.
+ */
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  uint32_t start_us = ssd1306_hal_time_us();
+  ssd1306_cmd_stream_t stream;
+  ssd1306_cmd_begin(&stream);
+  ssd1306_cmd_push(&stream, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
+  ssd1306_cmd_send(ssd, &stream);
+  ssd->config_us = ssd1306_hal_time_us() - start_us;
+}
+
+// --- Sequências de comandos ---
+// Com o byte de controle 0x00 (Co = 0, D/C = 0) o controlador interpreta todos os
+// bytes seguintes da transação como comandos, então uma sequência inteira paga uma
+// só vez START, endereço e STOP.
+
+void ssd1306_cmd_begin(ssd1306_cmd_stream_t *stream) {
+  stream->bytes[0] = SSD1306_CONTROL_CMD_STREAM;
+  stream->count = 0;
+  stream->overflow = false;
+}
+
+/**
+ * @brief Acrescenta comandos (e argumentos) à sequência.
+ *        Se não couberem, a sequência é marcada e ssd1306_cmd_send a recusa.
+ */
+void ssd1306_cmd_push(ssd1306_cmd_stream_t *stream, const uint8_t *commands, uint8_t count) {
+  if (stream->count + count > SSD1306_CMD_STREAM_MAX) {
+    stream->overflow = true;
+    return;
+  }
+  memcpy(&stream->bytes[1 + stream->count], commands, count);
+  stream->count += count;
+}
+
+/**
+ * @brief Envia a sequência em uma única transação I2C bloqueante.
+ *
+ * @return false se a sequência estourou SSD1306_CMD_STREAM_MAX ou está vazia.
+ */
+bool ssd1306_cmd_send(ssd1306_t *ssd, const ssd1306_cmd_stream_t *stream) {
+  if (stream->overflow || stream->count == 0) {
+    return false;
+  }
+  ssd1306_hal_i2c_write(ssd->i2c_port, ssd->address, stream->bytes, 1 + stream->count, false);
+  return true;
 }
 
+// Comando avulso (Co = 1): uma transação de 2 bytes
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  ssd1306_hal_i2c_write(
     ssd->i2c_port,
     ssd->address,
     ssd->port_buffer,
@@ -52,69 +186,360 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
+// Janela colunas [x0, x1] x páginas [p0, p1] a ser enviada
+typedef struct {
+  uint8_t x0, x1, p0, p1;
+} ssd1306_window_t;
+
+// Agrupa as páginas sujas em janelas e limpa o rastreamento. Páginas sujas
+// consecutivas formam uma única janela quando isso custa menos bytes no
+// barramento do que endereçá-las separadamente.
+static uint8_t ssd1306_plan_windows(ssd1306_t *ssd, ssd1306_window_t windows[SSD1306_MAX_PAGES]) {
+  uint8_t count = 0;
+  uint8_t page = 0;
+
+  while (page < ssd->pages) {
+    if (!ssd1306_page_dirty(ssd, page)) {
+      page++;
+      continue;
+    }
+
+    uint8_t p0 = page;
+    uint8_t x0 = ssd->dirty_x0[page];
+    uint8_t x1 = ssd->dirty_x1[page];
+    uint32_t run_cost = (uint32_t)(x1 - x0 + 1);
+
+    // Estende a janela enquanto a união custar menos que uma janela nova
+    while (page + 1 < ssd->pages && ssd1306_page_dirty(ssd, page + 1)) {
+      uint8_t nx0 = ssd->dirty_x0[page + 1] < x0 ? ssd->dirty_x0[page + 1] : x0;
+      uint8_t nx1 = ssd->dirty_x1[page + 1] > x1 ? ssd->dirty_x1[page + 1] : x1;
+      uint32_t merged = (uint32_t)(nx1 - nx0 + 1) * (page + 2 - p0);
+      uint32_t separate = run_cost + SSD1306_WINDOW_OVERHEAD_BYTES +
+                          (ssd->dirty_x1[page + 1] - ssd->dirty_x0[page + 1] + 1);
+      if (merged > separate) {
+        break;
+      }
+      x0 = nx0;
+      x1 = nx1;
+      run_cost = merged;
+      page++;
+    }
+
+    windows[count].x0 = x0;
+    windows[count].x1 = x1;
+    windows[count].p0 = p0;
+    windows[count].p1 = page;
+    count++;
+    for (uint8_t p = p0; p <= page; ++p) {
+      ssd1306_mark_clean(ssd, p);
+    }
+    page++;
+  }
+  return count;
+}
+
+// Comandos de endereçamento da janela (colunas e páginas), enviados em uma transação
+#define SSD1306_WINDOW_CMDS 6
+static inline void ssd1306_window_cmds(const ssd1306_window_t *w, uint8_t cmds[SSD1306_WINDOW_CMDS]) {
+  cmds[0] = SET_COL_ADDR;
+  cmds[1] = w->x0;
+  cmds[2] = w->x1;
+  cmds[3] = SET_PAGE_ADDR;
+  cmds[4] = w->p0;
+  cmds[5] = w->p1;
+}
+
+static void ssd1306_account(ssd1306_t *ssd, uint32_t sent) {
+  ssd->bytes_sent_last = sent;
+  ssd->bytes_sent_total += sent;
+  if (sent) {
+    ssd->frames_sent++;
+  }
+}
+
+// Envia uma janela de forma bloqueante. No modo de endereçamento vertical o
+// controlador percorre as páginas de cada coluna antes de avançar de coluna, a
+// mesma ordem do ram_buffer (índice 1 + x * 8 + página).
+static uint32_t ssd1306_send_window(ssd1306_t *ssd, const ssd1306_window_t *w) {
+  uint8_t cmds[SSD1306_WINDOW_CMDS];
+  ssd1306_cmd_stream_t stream;
+  uint32_t setup_start_us = ssd1306_hal_time_us();
+  ssd1306_window_cmds(w, cmds);
+  ssd1306_cmd_begin(&stream);
+  ssd1306_cmd_push(&stream, cmds, SSD1306_WINDOW_CMDS);
+  ssd1306_cmd_send(ssd, &stream);
+  ssd->window_setup_us_last += ssd1306_hal_time_us() - setup_start_us;
+
+  const uint8_t *data = ssd->ram_buffer;
+  size_t len = ssd->bufsize;
+  if (w->x0 != 0 || w->x1 != ssd->width - 1 || w->p0 != 0 || w->p1 != ssd->pages - 1) {
+    // Janela parcial: coleta os bytes na ordem em que o controlador os espera
+    len = 1;
+    for (uint16_t x = w->x0; x <= w->x1; ++x) {
+      const uint8_t *column = &ssd->ram_buffer[1 + (x << 3)];
+      for (uint8_t page = w->p0; page <= w->p1; ++page) {
+        ssd->tx_buffer[len++] = column[page];
+      }
+    }
+    data = ssd->tx_buffer;
+  }
+
+  ssd1306_hal_i2c_write(
     ssd->i2c_port,
     ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
+    data,
+    len,
     false
   );
+  return SSD1306_WINDOW_OVERHEAD_BYTES + (uint32_t)len;
+}
+
+/**
+ * @brief Envia ao display, de forma bloqueante, apenas as regiões alteradas
+ *        desde o último envio.
+ */
+void ssd1306_send_data(ssd1306_t *ssd) {
+  ssd1306_window_t windows[SSD1306_MAX_PAGES];
+  uint8_t count = ssd1306_plan_windows(ssd, windows);
+  uint32_t sent = 0;
+
+  ssd->window_setup_us_last = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    sent += ssd1306_send_window(ssd, &windows[i]);
+  }
+  ssd1306_account(ssd, sent);
+}
+
+/**
+ * @brief Monta em tx_words o fluxo de palavras IC_DATA_CMD das regiões alteradas:
+ *        para cada janela, uma transação com os 6 comandos de endereçamento
+ *        (byte de controle 0x00) e a transação de dados, cada uma terminada em STOP.
+ *        Os bytes são copiados, então o ram_buffer pode ser alterado em seguida.
+ *
+ * @return Número de palavras montadas (0 = nada a enviar).
+ */
+size_t ssd1306_build_stream(ssd1306_t *ssd) {
+  ssd1306_window_t windows[SSD1306_MAX_PAGES];
+  uint8_t count = ssd1306_plan_windows(ssd, windows);
+  uint16_t *out = ssd->tx_words;
+  uint32_t sent = 0;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    const ssd1306_window_t *w = &windows[i];
+    uint8_t cmds[SSD1306_WINDOW_CMDS];
+    ssd1306_window_cmds(w, cmds);
+    *out++ = SSD1306_CONTROL_CMD_STREAM;
+    for (uint8_t c = 0; c < SSD1306_WINDOW_CMDS; ++c) {
+      *out++ = cmds[c];
+    }
+    out[-1] |= I2C_DMA_STOP;
+
+    uint16_t *data_start = out;
+    *out++ = SSD1306_CONTROL_DATA;
+    for (uint16_t x = w->x0; x <= w->x1; ++x) {
+      const uint8_t *column = &ssd->ram_buffer[1 + (x << 3)];
+      for (uint8_t page = w->p0; page <= w->p1; ++page) {
+        *out++ = column[page];
+      }
+    }
+    out[-1] |= I2C_DMA_STOP;
+    sent += SSD1306_WINDOW_OVERHEAD_BYTES + (uint32_t)(out - data_start);
+  }
+
+  ssd1306_account(ssd, sent);
+  return (size_t)(out - ssd->tx_words);
+}
+
+/**
+ * @brief Inicia o envio das regiões alteradas via DMA e retorna imediatamente.
+ *        O próximo quadro pode ser desenhado enquanto este é transmitido, mas o
+ *        envio seguinte só pode começar após o callback.
+ *
+ * @param ssd Display (o I2C deve ter sido registrado com i2c_dma_init()).
+ * @param callback Chamado em contexto de interrupção ao fim da transmissão.
+ * @param ctx Argumento repassado ao callback.
+ * @return true se uma transmissão foi iniciada; false se não havia nada a enviar
+ *         ou se a anterior ainda está em andamento (nada é perdido nesse caso).
+ */
+bool ssd1306_send_data_async(ssd1306_t *ssd, i2c_dma_callback_t callback, void *ctx) {
+  if (i2c_dma_busy()) {
+    return false;
+  }
+
+  size_t count = ssd1306_build_stream(ssd);
+  if (count == 0) {
+    return false;
+  }
+
+  if (!i2c_dma_write(ssd->i2c_port, ssd->address, ssd->tx_words, count, callback, ctx)) {
+    // O rastreamento já foi limpo: força o reenvio completo no próximo quadro
+    ssd1306_mark_all_dirty(ssd);
+    return false;
+  }
+  return true;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= ssd->width || y >= ssd->height)
+    return;
   uint16_t index = (y >> 3) + (x << 3) + 1;
   uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+  uint8_t old = ssd->ram_buffer[index];
+  uint8_t updated = value ? (old | (1 << pixel)) : (old & ~(1 << pixel));
+  if (updated != old) {
+    ssd->ram_buffer[index] = updated;
+    ssd1306_mark_dirty(ssd, y >> 3, x);
+  }
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// === Blitter ===
+// O ram_buffer guarda cada coluna como 8 bytes consecutivos (um por página), com o
+// byte 0x40 na frente. Como ram_buffer + 1 é alinhado a 4 bytes (ver ssd1306_init),
+// a coluna x são duas palavras de 32 bits alinhadas: páginas 0-3 e 4-7, com a
+// linha y no bit (y % 32) da palavra y / 32. As primitivas abaixo escrevem bytes e
+// palavras inteiras em vez de um pixel por vez, e só marcam como sujas as páginas
+// cujos bytes realmente mudaram.
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
+static inline uint32_t *ssd1306_column_words(ssd1306_t *ssd, uint8_t x) {
+  return (uint32_t *)&ssd->ram_buffer[1 + (x << 3)];
+}
+
+// Máscara das linhas [y0, y1] (0..63) dentro da palavra `word` (0 ou 1) de uma coluna
+static inline uint32_t ssd1306_rows_mask(uint8_t y0, uint8_t y1, uint8_t word) {
+  int lo = (int)y0 - 32 * word;
+  int hi = (int)y1 - 32 * word;
+  if (lo < 0) lo = 0;
+  if (hi > 31) hi = 31;
+  if (lo > hi) return 0;
+  return (0xFFFFFFFFu >> (31 - hi)) & (0xFFFFFFFFu << lo);
+}
+
+// Aplica `mask` (ligando ou desligando) a uma palavra da coluna x
+static inline void ssd1306_apply_word(ssd1306_t *ssd, uint32_t *column, uint8_t word, uint8_t x,
+                                      uint32_t mask, bool value) {
+  uint32_t old = column[word];
+  uint32_t updated = value ? (old | mask) : (old & ~mask);
+  uint32_t diff = old ^ updated;
+  if (diff == 0) return;
+  column[word] = updated;
+  for (uint8_t b = 0; b < 4; ++b) {
+    if (diff & (0xFFu << (8 * b))) ssd1306_mark_dirty(ssd, 4 * word + b, x);
+  }
+}
+
+// Substitui o byte (x, page), marcando a página se ele mudou
+static inline void ssd1306_write_byte(ssd1306_t *ssd, uint8_t x, uint8_t page, uint8_t keep_mask, uint8_t bits) {
+  uint8_t *p = &ssd->ram_buffer[1 + (x << 3) + page];
+  uint8_t updated = (uint8_t)((*p & keep_mask) | (bits & ~keep_mask));
+  if (updated != *p) {
+    *p = updated;
+    ssd1306_mark_dirty(ssd, page, x);
+  }
+}
+
+/**
+ * @brief Apresenta o quadro desenhado no back buffer (modo de dois buffers).
+ *        Compara cada coluna com o front buffer, duas palavras de 32 bits por vez,
+ *        marca como sujas só as páginas que diferem e as copia para o front.
+ *        Desenhar e apagar algo dentro do mesmo quadro não gera envio.
+ *        Sem front buffer (ssd1306_init) não faz nada.
+ *
+ * @return Bytes do quadro que mudaram desde a última apresentação.
+ */
+uint32_t ssd1306_present(ssd1306_t *ssd) {
+  if (ssd->front_buffer == NULL) return 0;
+
+  uint32_t changed = 0;
+  uint32_t *front = (uint32_t *)ssd->front_buffer;
+  for (uint8_t x = 0; x < ssd->width; ++x) {
+    const uint32_t *back = ssd1306_column_words(ssd, x);
+    for (uint8_t word = 0; word < 2; ++word) {
+      uint32_t diff = back[word] ^ front[2 * x + word];
+      if (diff == 0) continue;
+      front[2 * x + word] = back[word];
+      for (uint8_t b = 0; b < 4; ++b) {
+        if (diff & (0xFFu << (8 * b))) {
+          ssd1306_extend_dirty(ssd, 4 * word + b, x);
+          changed++;
         }
+      }
     }
+  }
+  return changed;
 }
 
+/**
+ * @brief Preenche o retângulo [x, x + w) x [y, y + h), recortado à tela.
+ *        Cada coluna é atualizada com no máximo duas operações de 32 bits.
+ */
+void ssd1306_fill_rect(ssd1306_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, bool value) {
+  int16_t x1 = x + w - 1;
+  int16_t y1 = y + h - 1;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+  if (y1 >= ssd->height) y1 = ssd->height - 1;
+  if (x > x1 || y > y1) return;
 
-
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  uint32_t mask_lo = ssd1306_rows_mask((uint8_t)y, (uint8_t)y1, 0);
+  uint32_t mask_hi = ssd1306_rows_mask((uint8_t)y, (uint8_t)y1, 1);
+  for (int16_t cx = x; cx <= x1; ++cx) {
+    uint32_t *column = ssd1306_column_words(ssd, (uint8_t)cx);
+    if (mask_lo) ssd1306_apply_word(ssd, column, 0, (uint8_t)cx, mask_lo, value);
+    if (mask_hi) ssd1306_apply_word(ssd, column, 1, (uint8_t)cx, mask_hi, value);
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  ssd1306_fill_rect(ssd, 0, 0, ssd->width, ssd->height, value);
+}
+
+// Segmento horizontal: um bit por coluna, todos no mesmo byte de página
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  if (x0 > x1) { uint8_t t = x0; x0 = x1; x1 = t; }
+  if (y >= ssd->height || x0 >= ssd->width) return;
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+
+  uint8_t page = y >> 3;
+  uint8_t bit = (uint8_t)(1u << (y & 7));
+  uint8_t bits = value ? bit : 0;
+  for (uint16_t x = x0; x <= x1; ++x) {
+    ssd1306_write_byte(ssd, (uint8_t)x, page, (uint8_t)~bit, bits);
   }
+}
+
+// Segmento vertical: uma coluna, no máximo duas palavras
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  if (y0 > y1) { uint8_t t = y0; y0 = y1; y1 = t; }
+  ssd1306_fill_rect(ssd, x, y0, 1, (int16_t)(y1 - y0 + 1), value);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0) return;
+  int16_t right = left + width - 1;
+  int16_t bottom = top + height - 1;
+
+  ssd1306_fill_rect(ssd, left, top, width, 1, value);
+  ssd1306_fill_rect(ssd, left, bottom, width, 1, value);
+  ssd1306_fill_rect(ssd, left, top, 1, height, value);
+  ssd1306_fill_rect(ssd, right, top, 1, height, value);
 
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    ssd1306_fill_rect(ssd, left + 1, top + 1, width - 2, height - 2, value);
   }
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    // Retas horizontais e verticais usam os segmentos do blitter
+    if (y0 == y1) {
+        ssd1306_hline(ssd, x0, x1, y0, value);
+        return;
+    }
+    if (x0 == x1) {
+        ssd1306_vline(ssd, x0, y0, y1, value);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -142,15 +567,49 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
     }
 }
 
+/**
+ * @brief Copia um bitmap de `pages` páginas de altura, opaco (grava também o fundo).
+ *        `data` traz uma faixa de `stride` bytes por página, dos quais `width` são
+ *        copiados; cada byte é uma coluna, com a linha 0 no bit 0 (formato do font.h).
+ *        Com y múltiplo de 8 cada coluna é um byte por página; caso contrário, cada
+ *        faixa é deslocada e dividida entre duas páginas.
+ */
+void ssd1306_blit_pages(ssd1306_t *ssd, const uint8_t *data, uint8_t width, uint8_t stride, uint8_t pages, uint8_t x, uint8_t y) {
+  if (y >= ssd->height) return;
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  uint8_t first_page = y >> 3;
+  uint8_t shift = y & 7;
+  uint8_t keep_lo = (uint8_t)~(0xFFu << shift);
+  uint8_t keep_hi = (uint8_t)(0xFFu << shift);
+
+  for (uint8_t p = 0; p < pages; ++p) {
+    uint8_t page = first_page + p;
+    if (page >= ssd->pages) break;
+    bool has_next_page = shift != 0 && (uint8_t)(page + 1) < ssd->pages;
+    const uint8_t *columns = data + (size_t)p * stride;
+
+    for (uint8_t i = 0; i < width; ++i) {
+      uint16_t cx = (uint16_t)x + i;
+      if (cx >= ssd->width) break;
+      uint8_t bits = columns[i];
+      if (shift == 0) {
+        ssd1306_write_byte(ssd, (uint8_t)cx, page, 0x00, bits);
+      } else {
+        // A parte baixa da página seguinte é sobrescrita pela faixa p + 1, se houver
+        ssd1306_write_byte(ssd, (uint8_t)cx, page, keep_lo, (uint8_t)(bits << shift));
+        if (has_next_page) {
+          ssd1306_write_byte(ssd, (uint8_t)cx, page + 1, keep_hi, (uint8_t)(bits >> (8 - shift)));
+        }
+      }
+    }
+  }
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+/**
+ * @brief Copia um bitmap de 8 linhas de altura, opaco (grava também o fundo).
+ */
+void ssd1306_blit_glyph(ssd1306_t *ssd, const uint8_t *columns, uint8_t width, uint8_t x, uint8_t y) {
+  ssd1306_blit_pages(ssd, columns, width, width, 1, x, y);
 }
 
 // Função para desenhar um caractere
@@ -169,15 +628,8 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
     index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
   }
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
-    }
-  }
+  // Cada glifo são 8 colunas de 8 pixels: copia por bytes em vez de pixel a pixel
+  ssd1306_blit_glyph(ssd, &font[index], 8, x, y);
 }
 
 // Função para desenhar uma string
@@ -197,4 +649,137 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
       break;
     }
   }
-}
\ No newline at end of file
+}
+
+// --- Texto com fontes em formato de página ---
+
+static inline uint8_t ssd1306_glyph_index(const ssd1306_font_t *font, char c) {
+  return (c >= font->first && c <= font->last) ? (uint8_t)(c - font->first) : 0;
+}
+
+static inline uint8_t ssd1306_glyph_width(const ssd1306_font_t *font, uint8_t g) {
+  return font->widths ? font->widths[g] : font->stride;
+}
+
+// Primeira coluna usada do glifo g na página 0
+static inline const uint8_t *ssd1306_glyph_columns(const ssd1306_font_t *font, uint8_t g) {
+  return font->glyphs + (size_t)g * font->pages * font->stride + (font->offsets ? font->offsets[g] : 0);
+}
+
+/**
+ * @brief Largura em pixels de `str` na fonte, incluindo o espaçamento após cada glifo.
+ */
+uint16_t ssd1306_text_width(const ssd1306_font_t *font, const char *str) {
+  uint16_t width = 0;
+  while (*str) {
+    width += ssd1306_glyph_width(font, ssd1306_glyph_index(font, *str++)) + font->spacing;
+  }
+  return width;
+}
+
+/**
+ * @brief Desenha `str` em uma linha, sem quebra, recortando na borda direita.
+ *        Os glifos são copiados página a página, já no formato do ram_buffer.
+ *
+ * @return Coluna logo após o texto (limitada à largura da tela).
+ */
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y) {
+  uint16_t cx = x;
+  while (*str && cx < ssd->width) {
+    uint8_t g = ssd1306_glyph_index(font, *str++);
+    uint8_t width = ssd1306_glyph_width(font, g);
+    ssd1306_blit_pages(ssd, ssd1306_glyph_columns(font, g), width, font->stride, font->pages, (uint8_t)cx, y);
+    cx += width;
+    if (font->spacing) {
+      ssd1306_fill_rect(ssd, (int16_t)cx, y, font->spacing, (int16_t)(font->pages * 8), false);
+      cx += font->spacing;
+    }
+  }
+  return (cx < ssd->width) ? (uint8_t)cx : ssd->width;
+}
+
+// --- Cache de faixas pré-renderizadas ---
+//
+// Textos desenhados a cada quadro (rótulos fixos) são rasterizados uma vez em uma
+// faixa no formato do ram_buffer; os quadros seguintes só copiam a faixa.
+// Substituição LRU. Compartilhado por todos os displays; não é reentrante
+// (apenas uma tarefa deve desenhar).
+
+typedef struct {
+  const ssd1306_font_t *font;         // NULL = posição livre
+  char text[SSD1306_STRIP_TEXT_MAX];
+  uint8_t width;                      // Colunas da faixa (stride de cada página)
+  uint32_t last_use;
+  uint8_t data[SSD1306_STRIP_BYTES];  // `font->pages` faixas de `width` bytes
+} ssd1306_strip_t;
+
+static ssd1306_strip_t strip_cache[SSD1306_STRIP_CACHE_SLOTS];
+static uint32_t strip_clock;
+static uint32_t strip_hits;
+static uint32_t strip_misses;
+
+static void ssd1306_strip_render(ssd1306_strip_t *strip, const ssd1306_font_t *font, const char *str, uint8_t width) {
+  uint8_t *out = strip->data;
+  for (const char *c = str; *c; ++c) {
+    uint8_t g = ssd1306_glyph_index(font, *c);
+    uint8_t glyph_width = ssd1306_glyph_width(font, g);
+    const uint8_t *columns = ssd1306_glyph_columns(font, g);
+    for (uint8_t p = 0; p < font->pages; ++p) {
+      memcpy(out + (size_t)p * width, columns + (size_t)p * font->stride, glyph_width);
+      memset(out + (size_t)p * width + glyph_width, 0, font->spacing);
+    }
+    out += glyph_width + font->spacing;
+  }
+  strip->font = font;
+  strip->width = width;
+  memcpy(strip->text, str, strlen(str) + 1); // O chamador garante strlen(str) < SSD1306_STRIP_TEXT_MAX
+}
+
+/**
+ * @brief Como ssd1306_draw_text, mas copia uma faixa pré-renderizada de `str`.
+ *        Na primeira vez (ou após ser descartada) a faixa é rasterizada e guardada.
+ *        Textos longos demais para uma posição do cache são desenhados direto.
+ *
+ * @return Coluna logo após o texto (limitada à largura da tela).
+ */
+uint8_t ssd1306_draw_text_cached(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y) {
+  ssd1306_strip_t *strip = NULL;
+  ssd1306_strip_t *victim = &strip_cache[0];
+
+  strip_clock++;
+  for (uint8_t i = 0; i < SSD1306_STRIP_CACHE_SLOTS; ++i) {
+    ssd1306_strip_t *slot = &strip_cache[i];
+    if (slot->font == font && strcmp(slot->text, str) == 0) {
+      strip = slot;
+      break;
+    }
+    if (slot->font == NULL || (victim->font != NULL && slot->last_use < victim->last_use)) {
+      victim = slot;
+    }
+  }
+
+  if (strip != NULL) {
+    strip_hits++;
+  } else {
+    strip_misses++;
+    uint16_t width = ssd1306_text_width(font, str);
+    if (strlen(str) >= SSD1306_STRIP_TEXT_MAX || (uint32_t)width * font->pages > SSD1306_STRIP_BYTES) {
+      return ssd1306_draw_text(ssd, font, str, x, y);
+    }
+    strip = victim;
+    ssd1306_strip_render(strip, font, str, (uint8_t)width);
+  }
+  strip->last_use = strip_clock;
+
+  ssd1306_blit_pages(ssd, strip->data, strip->width, strip->width, font->pages, x, y);
+  uint16_t end = (uint16_t)x + strip->width;
+  return (end < ssd->width) ? (uint8_t)end : ssd->width;
+}
+
+/**
+ * @brief Acertos e faltas do cache de faixas desde a inicialização.
+ */
+void ssd1306_strip_cache_stats(uint32_t *hits, uint32_t *misses) {
+  *hits = strip_hits;
+  *misses = strip_misses;
+}
@@ -1,9 +1,47 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "i2c_dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES 8 // Páginas de 8 linhas rastreadas pelo controle de regiões sujas
+
+// Byte de controle (Co = 0): todos os bytes seguintes da transação são comandos
+#define SSD1306_CONTROL_CMD_STREAM 0x00
+// Byte de controle (Co = 0, D/C = 1): todos os bytes seguintes da transação são dados
+#define SSD1306_CONTROL_DATA       0x40
+
+#define SSD1306_CMD_STREAM_MAX 32 // Comandos em uma única transação (ssd1306_cmd_stream_t)
+
+// Custo fixo, em bytes no barramento, de endereçar uma janela: uma transação de
+// comandos (endereço I2C, byte de controle e 6 comandos) mais o endereço I2C da
+// escrita de dados
+#define SSD1306_WINDOW_OVERHEAD_BYTES (1 + 1 + 6 + 1)
+
+// Cache de faixas pré-renderizadas (ssd1306_draw_text_cached)
+#ifndef SSD1306_STRIP_CACHE_SLOTS
+#define SSD1306_STRIP_CACHE_SLOTS 12  // Textos fixos mantidos renderizados
+#endif
+#define SSD1306_STRIP_TEXT_MAX   16   // Chave: até 15 caracteres + '\0'
+#define SSD1306_STRIP_BYTES      128  // Largura x páginas de uma faixa (ex.: 128 colunas de 1 página)
+
+// Palavras do fluxo DMA no pior caso: 7 de comandos + 1 de controle por janela, mais os dados
+#define SSD1306_STREAM_WORDS(width, pages) ((size_t)(width) * (pages) + (size_t)(pages) * 8)
+
+// Buffers de uma tela de até WIDTH x HEIGHT para ssd1306_init_buffered, em
+// memória estática. Cada coluna ocupa 8 bytes (SSD1306_MAX_PAGES) no quadro.
+#define SSD1306_FRAME_BYTES ((size_t)WIDTH * SSD1306_MAX_PAGES)
+
+typedef struct {
+  uint32_t back[(SSD1306_FRAME_BYTES + 4) / 4];  // 3 bytes de folga + 0x40 + quadro em desenho
+  uint32_t front[SSD1306_FRAME_BYTES / 4];       // Último quadro apresentado (o que o painel mostra)
+  uint8_t tx[SSD1306_FRAME_BYTES + 1];
+  uint16_t words[SSD1306_STREAM_WORDS(WIDTH, SSD1306_MAX_PAGES)];
+} ssd1306_framebuffers_t;
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -25,21 +63,64 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Sequência de comandos enviada em uma única transação I2C: byte de controle 0x00
+// seguido dos comandos e seus argumentos
+typedef struct {
+  uint8_t bytes[1 + SSD1306_CMD_STREAM_MAX];
+  uint8_t count;                            // Comandos/argumentos acumulados
+  bool overflow;                            // Algum comando não coube (a sequência não é enviada)
+} ssd1306_cmd_stream_t;
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
-  uint8_t *ram_buffer;
+  uint8_t *ram_buffer;                      // Quadro em desenho (back buffer)
+  uint8_t *front_buffer;                    // Modo de dois buffers: último quadro apresentado; NULL = um buffer
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t *tx_buffer;                       // Byte 0x40 + dados de uma janela (coletados do ram_buffer)
+  uint16_t *tx_words;                       // Fluxo IC_DATA_CMD do envio via DMA (ssd1306_send_data_async)
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];      // Primeira coluna alterada por página (x0 > x1 = página limpa)
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];      // Última coluna alterada por página
+  uint32_t bytes_sent_last;                 // Bytes enviados pelo último ssd1306_send_data
+  uint32_t bytes_sent_total;                // Bytes enviados desde a inicialização
+  uint32_t frames_sent;                     // Chamadas de ssd1306_send_data com algo a enviar
+  uint32_t config_us;                       // Duração de ssd1306_config (sequência de inicialização)
+  uint32_t window_setup_us_last;            // Endereçamento das janelas no último ssd1306_send_data
 } ssd1306_t;
 
+// Fonte em formato de página. O glifo g ocupa `pages` faixas de `stride` bytes a partir de
+// glyphs[g * pages * stride]; cada byte é uma coluna de 8 linhas com a linha 0 no bit 0.
+typedef struct {
+  const uint8_t *glyphs;
+  const uint8_t *offsets;  // Primeira coluna usada de cada glifo (NULL = 0)
+  const uint8_t *widths;   // Colunas usadas de cada glifo (NULL = stride, monoespaçada)
+  uint8_t stride;          // Colunas reservadas por glifo na tabela
+  uint8_t pages;           // Altura em páginas de 8 linhas
+  uint8_t spacing;         // Colunas em branco após cada glifo
+  char first, last;        // Faixa coberta; fora dela é desenhado o glifo `first`
+} ssd1306_font_t;
+
+extern const ssd1306_font_t ssd1306_font_8x8;      // font.h, monoespaçada (igual a ssd1306_draw_string)
+extern const ssd1306_font_t ssd1306_font_prop;     // font.h recortada, proporcional, 8 px de altura
+extern const ssd1306_font_t ssd1306_font_digits16; // Dígitos 16x16 (' '..'9', inclui '%' e '-')
+
 // === Protótipos de Funções ===
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+bool ssd1306_init_buffered(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address,
+                           i2c_inst_t *i2c, ssd1306_framebuffers_t *buffers);
+uint32_t ssd1306_present(ssd1306_t *ssd);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_cmd_begin(ssd1306_cmd_stream_t *stream);
+void ssd1306_cmd_push(ssd1306_cmd_stream_t *stream, const uint8_t *commands, uint8_t count);
+bool ssd1306_cmd_send(ssd1306_t *ssd, const ssd1306_cmd_stream_t *stream);
 void ssd1306_send_data(ssd1306_t *ssd);
+size_t ssd1306_build_stream(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd, i2c_dma_callback_t callback, void *ctx);
+void ssd1306_mark_all_dirty(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -47,5 +128,14 @@ void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_fill_rect(ssd1306_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, bool value);
+void ssd1306_blit_glyph(ssd1306_t *ssd, const uint8_t *columns, uint8_t width, uint8_t x, uint8_t y);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_blit_pages(ssd1306_t *ssd, const uint8_t *data, uint8_t width, uint8_t stride, uint8_t pages, uint8_t x, uint8_t y);
+uint16_t ssd1306_text_width(const ssd1306_font_t *font, const char *str);
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_text_cached(ssd1306_t *ssd, const ssd1306_font_t *font, const char *str, uint8_t x, uint8_t y);
+void ssd1306_strip_cache_stats(uint32_t *hits, uint32_t *misses);
+
+#endif // SSD1306_H
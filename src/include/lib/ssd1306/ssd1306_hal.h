@@ -0,0 +1,24 @@
+#ifndef SSD1306_HAL_H
+#define SSD1306_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+// Acesso ao hardware usado pelo driver, fora o DMA (i2c_dma.h): a escrita I2C
+// bloqueante (configuração e ssd1306_send_data) e o relógio das medições.
+// No firmware são as funções do SDK. Um build de host define SSD1306_HOST_HAL e
+// fornece as duas funções, por exemplo emulando o controlador, do mesmo jeito que
+// fornece i2c_dma_write().
+
+#ifdef SSD1306_HOST_HAL
+int ssd1306_hal_i2c_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+uint32_t ssd1306_hal_time_us(void);
+#else
+#include "pico/time.h"
+#define ssd1306_hal_i2c_write i2c_write_blocking
+#define ssd1306_hal_time_us   time_us_32
+#endif
+
+#endif // SSD1306_HAL_H
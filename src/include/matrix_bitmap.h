@@ -0,0 +1,52 @@
+#ifndef MATRIX_BITMAP_H
+#define MATRIX_BITMAP_H
+
+#include <stdint.h>
+#include "led_color.h"
+
+// Ícones da matriz 5x5 como máscaras de 25 bits montadas em tempo de compilação.
+//
+// Cada ícone é escrito como arte ASCII: uma macro com cinco literais binários,
+// um por linha da matriz (de cima para baixo, bit mais significativo = coluna da
+// esquerda), ex.: #define ICON_EXEMPLO 0b01010, 0b00100, 0b10101, 0b01010, 0b00100
+// com cada linha em uma linha do código (ver led_matrix.c).
+//
+// MATRIX_FRAME() monta a máscara na ordem de uma imagem: o bit y * 5 + x é o
+// pixel da coluna x (da esquerda) e da linha y (de cima), o mesmo índice do
+// buffer de pixels. A ordem dos LEDs na fita fica com a geometria da saída
+// (led_layout.h), aplicada por led_strip_show(), então os ícones não dependem de
+// como a matriz foi montada. Desenhar um ícone é só preencher os bits acesos.
+// MATRIX_ROLL_DOWN/UP giram as linhas de um ícone, para animações verticais.
+
+// Inverte as 5 colunas de uma linha: na arte ASCII a coluna 0 é o bit 4
+#define MATRIX_ROW_REVERSED(r) ((((r) & 0x01) << 4) | (((r) & 0x02) << 2) | ((r) & 0x04) | \
+                                (((r) & 0x08) >> 2) | (((r) & 0x10) >> 4))
+
+#define MATRIX_FRAME_ROWS(r0, r1, r2, r3, r4) \
+    (((uint32_t)MATRIX_ROW_REVERSED(r0) << 0) | ((uint32_t)MATRIX_ROW_REVERSED(r1) << 5) | \
+     ((uint32_t)MATRIX_ROW_REVERSED(r2) << 10) | ((uint32_t)MATRIX_ROW_REVERSED(r3) << 15) | \
+     ((uint32_t)MATRIX_ROW_REVERSED(r4) << 20))
+#define MATRIX_FRAME(...) MATRIX_FRAME_ROWS(__VA_ARGS__)
+
+// Gira as linhas uma posição para baixo (a última volta ao topo) ou para cima
+#define MATRIX_ROLL_DOWN_ROWS(r0, r1, r2, r3, r4) r4, r0, r1, r2, r3
+#define MATRIX_ROLL_UP_ROWS(r0, r1, r2, r3, r4)   r1, r2, r3, r4, r0
+#define MATRIX_ROLL_DOWN(...) MATRIX_ROLL_DOWN_ROWS(__VA_ARGS__)
+#define MATRIX_ROLL_UP(...)   MATRIX_ROLL_UP_ROWS(__VA_ARGS__)
+
+// As `rows` linhas de baixo acesas (0 a 5): os últimos 5 * rows pixels da imagem
+#define MATRIX_BOTTOM_ROWS(rows) ((uint32_t)(((1ull << (5 * (rows))) - 1) << (5 * (5 - (rows)))))
+
+/**
+ * @brief Preenche com `color` os pixels cujos bits estão acesos em `mask`;
+ *        os demais ficam como estão.
+ */
+static inline void matrix_bitmap_fill(led_color_t *pixels, uint32_t mask, led_color_t color) {
+    for (uint8_t i = 0; mask != 0; ++i, mask >>= 1) {
+        if (mask & 1u) {
+            pixels[i] = color;
+        }
+    }
+}
+
+#endif // MATRIX_BITMAP_H
@@ -0,0 +1,108 @@
+#include "sample_ring.h"
+
+/**
+ * @brief Inicializa o anel sobre um armazenamento fornecido pelo chamador.
+ *
+ * @param ring Anel a ser inicializado.
+ * @param storage Memória com SAMPLE_RING_BLOCKS * block_samples * channels palavras.
+ * @param block_samples Número de amostras por canal em cada bloco.
+ * @param channels Número de canais intercalados em cada bloco.
+ */
+void sample_ring_init(sample_ring_t *ring, uint16_t *storage, uint16_t block_samples, uint8_t channels) {
+    ring->storage = storage;
+    ring->block_samples = block_samples;
+    ring->channels = channels;
+    for (uint8_t i = 0; i < SAMPLE_RING_BLOCKS; ++i) {
+        ring->ready[i] = 0;
+    }
+    ring->write_block = 0;
+    ring->read_block = 0;
+    ring->blocks_completed = 0;
+    ring->overruns = 0;
+}
+
+/**
+ * @brief Retorna o tamanho de um bloco em palavras de 16 bits (todas as amostras de todos os canais).
+ */
+size_t sample_ring_block_words(const sample_ring_t *ring) {
+    return (size_t)ring->block_samples * ring->channels;
+}
+
+/**
+ * @brief Retorna o endereço do bloco `index` dentro do armazenamento.
+ */
+uint16_t *sample_ring_block(const sample_ring_t *ring, uint8_t index) {
+    return ring->storage + (size_t)index * sample_ring_block_words(ring);
+}
+
+/**
+ * @brief Chamado pelo produtor quando o bloco em escrita fica cheio.
+ *        Marca o bloco como pronto e avança para o próximo. Se o consumidor
+ *        ainda não tinha liberado esse bloco, a ocorrência é contada como overrun.
+ *
+ * @return Índice do bloco que acabou de ser concluído (para o produtor rearmá-lo).
+ */
+uint8_t sample_ring_commit(sample_ring_t *ring) {
+    uint8_t completed = ring->write_block;
+    if (ring->ready[completed]) {
+        ring->overruns++;
+    }
+    ring->ready[completed] = 1;
+    ring->write_block = (uint8_t)((completed + 1) % SAMPLE_RING_BLOCKS);
+    ring->blocks_completed++;
+    return completed;
+}
+
+/**
+ * @brief Obtém o bloco pronto mais antigo, na ordem em que foram concluídos.
+ *        O bloco em write_block já está sendo reescrito pelo produtor (o DMA
+ *        encadeado recomeça nele assim que o commit acontece); se ele ainda estiver
+ *        marcado como pronto, mistura amostras antigas e novas, então é descartado
+ *        e contado como overrun. Os demais são entregues a partir do mais antigo;
+ *        com dois blocos, sobra o último concluído (write_block - 1).
+ *        Não deve ser interrompida por sample_ring_commit() (o produtor real é
+ *        uma ISR: o chamador desabilita as interrupções em volta).
+ *
+ * @return Ponteiro para as amostras intercaladas do bloco ou NULL se nenhum estiver pronto.
+ */
+const uint16_t *sample_ring_acquire(sample_ring_t *ring) {
+    uint8_t start = ring->write_block;
+    if (ring->ready[start]) {
+        ring->ready[start] = 0;
+        ring->overruns++;
+    }
+    for (uint8_t i = 1; i < SAMPLE_RING_BLOCKS; ++i) {
+        uint8_t index = (uint8_t)((start + i) % SAMPLE_RING_BLOCKS);
+        if (ring->ready[index]) {
+            ring->read_block = index;
+            return sample_ring_block(ring, index);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Devolve ao produtor o bloco obtido por sample_ring_acquire().
+ */
+void sample_ring_release(sample_ring_t *ring) {
+    ring->ready[ring->read_block] = 0;
+}
+
+/**
+ * @brief Calcula a média inteira de um canal dentro de um bloco intercalado.
+ *
+ * @param block Amostras intercaladas (canal 0, canal 1, ..., canal 0, ...).
+ * @param block_samples Amostras por canal no bloco.
+ * @param channels Número de canais intercalados.
+ * @param channel Canal desejado.
+ */
+uint16_t sample_ring_channel_mean(const uint16_t *block, uint16_t block_samples, uint8_t channels, uint8_t channel) {
+    if (block_samples == 0) {
+        return 0;
+    }
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < block_samples; ++i) {
+        sum += block[(size_t)i * channels + channel];
+    }
+    return (uint16_t)((sum + block_samples / 2) / block_samples);
+}
@@ -0,0 +1,36 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Anel de blocos duplo (ping-pong) para amostras intercaladas do ADC.
+// Não depende do Pico SDK nem do FreeRTOS: o produtor (ISR do DMA ou um
+// gerador sintético no host) chama sample_ring_commit() a cada bloco cheio
+// e o consumidor usa sample_ring_acquire()/sample_ring_release().
+
+#define SAMPLE_RING_BLOCKS 2
+
+typedef struct {
+    uint16_t *storage;                          // SAMPLE_RING_BLOCKS blocos contíguos
+    uint16_t block_samples;                     // Amostras por canal em cada bloco
+    uint8_t channels;                           // Canais intercalados (round-robin)
+    volatile uint8_t ready[SAMPLE_RING_BLOCKS]; // 1 = bloco cheio aguardando o consumidor
+    volatile uint8_t write_block;               // Bloco sendo preenchido pelo produtor
+    uint8_t read_block;                         // Bloco entregue ao consumidor pelo último acquire
+    volatile uint32_t blocks_completed;         // Total de blocos entregues pelo produtor
+    volatile uint32_t overruns;                 // Blocos perdidos: sobrescritos ou descartados em reescrita
+} sample_ring_t;
+
+void sample_ring_init(sample_ring_t *ring, uint16_t *storage, uint16_t block_samples, uint8_t channels);
+size_t sample_ring_block_words(const sample_ring_t *ring);
+uint16_t *sample_ring_block(const sample_ring_t *ring, uint8_t index);
+
+uint8_t sample_ring_commit(sample_ring_t *ring);
+const uint16_t *sample_ring_acquire(sample_ring_t *ring);
+void sample_ring_release(sample_ring_t *ring);
+
+uint16_t sample_ring_channel_mean(const uint16_t *block, uint16_t block_samples, uint8_t channels, uint8_t channel);
+
+#endif // SAMPLE_RING_H
@@ -0,0 +1,84 @@
+#include "sensor_convert.h"
+
+/**
+ * @brief Pré-calcula a escala Q22 para uma faixa de calibração do ADC.
+ *
+ * @param conv Conversor a ser inicializado.
+ * @param raw_min Leitura crua equivalente a 0%.
+ * @param raw_max Leitura crua equivalente a 100%.
+ */
+void sensor_convert_init(sensor_convert_t *conv, uint16_t raw_min, uint16_t raw_max) {
+    conv->raw_min = raw_min;
+    conv->raw_max = raw_max;
+    conv->span = (raw_max > raw_min) ? (uint16_t)(raw_max - raw_min) : 0;
+    if (conv->span == 0) {
+        conv->scale_q22 = 0;
+        conv->scale_q18 = 0;
+        return;
+    }
+    conv->scale_q22 = (uint32_t)((((uint64_t)SENSOR_PERMILLE_FULL_SCALE << SENSOR_SCALE_SHIFT) + conv->span - 1) / conv->span);
+    conv->scale_q18 = (uint32_t)((((uint64_t)SENSOR_PERMILLE_FULL_SCALE << (SENSOR_SCALE_SHIFT - SENSOR_Q4_FRAC_BITS)) + conv->span - 1) / conv->span);
+}
+
+/**
+ * @brief Converte uma leitura crua em permilagem (0-1000) sem ponto flutuante.
+ *        O resultado é idêntico a floor((raw - min) * 1000 / span) para qualquer
+ *        leitura, com a leitura limitada à faixa de calibração.
+ *
+ * @param conv Conversor inicializado com sensor_convert_init().
+ * @param raw Leitura crua do ADC.
+ */
+uint16_t sensor_convert_permille(const sensor_convert_t *conv, uint16_t raw) {
+    if (raw <= conv->raw_min || conv->span == 0) {
+        return 0;
+    }
+    if (raw >= conv->raw_max) {
+        return SENSOR_PERMILLE_FULL_SCALE;
+    }
+
+    uint32_t offset = (uint32_t)(raw - conv->raw_min);
+    uint32_t permille = (offset * conv->scale_q22) >> SENSOR_SCALE_SHIFT;
+    // A escala é arredondada para cima, então a estimativa excede o valor exato em no máximo 1.
+    if (permille * conv->span > offset * SENSOR_PERMILLE_FULL_SCALE) {
+        permille--;
+    }
+    return (uint16_t)permille;
+}
+
+/**
+ * @brief Converte uma leitura filtrada em Q4 (ver sensor_filter) em permilagem,
+ *        aproveitando os bits extras da sobreamostragem. Mesmo critério de
+ *        arredondamento de sensor_convert_permille().
+ *
+ * @param conv Conversor inicializado com sensor_convert_init().
+ * @param value_q4 Leitura em Q4 (leitura de 12 bits << 4).
+ */
+uint16_t sensor_convert_permille_q4(const sensor_convert_t *conv, uint16_t value_q4) {
+    uint32_t min_q4 = (uint32_t)conv->raw_min << SENSOR_Q4_FRAC_BITS;
+    uint32_t max_q4 = (uint32_t)conv->raw_max << SENSOR_Q4_FRAC_BITS;
+    if (value_q4 <= min_q4 || conv->span == 0) {
+        return 0;
+    }
+    if (value_q4 >= max_q4) {
+        return SENSOR_PERMILLE_FULL_SCALE;
+    }
+
+    // offset_q4 * 1000 * 2^18 / span / 2^22 = offset * 1000 / span
+    uint32_t offset_q4 = value_q4 - min_q4;
+    uint32_t permille = (offset_q4 * conv->scale_q18) >> SENSOR_SCALE_SHIFT;
+    if ((permille * conv->span) << SENSOR_Q4_FRAC_BITS > offset_q4 * SENSOR_PERMILLE_FULL_SCALE) {
+        permille--;
+    }
+    return (uint16_t)permille;
+}
+
+/**
+ * @brief Converte permilagem (0-1000) em percentual inteiro truncado (0-100).
+ *        Usa multiplicação recíproca (205 / 2^11), exata nessa faixa, em vez de divisão.
+ */
+uint8_t sensor_permille_to_percent(uint16_t permille) {
+    if (permille >= SENSOR_PERMILLE_FULL_SCALE) {
+        return 100;
+    }
+    return (uint8_t)(((uint32_t)permille * 205u) >> 11);
+}
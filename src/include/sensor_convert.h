@@ -0,0 +1,27 @@
+#ifndef SENSOR_CONVERT_H
+#define SENSOR_CONVERT_H
+
+#include <stdint.h>
+
+// Conversão inteira (ponto fixo) de leituras cruas do ADC para permilagem (0-1000,
+// resolução de 0,1%). O RP2040 não tem FPU, então a escala é pré-calculada uma única
+// vez a partir da faixa de calibração e cada amostra custa apenas multiplicações e shifts.
+
+#define SENSOR_PERMILLE_FULL_SCALE 1000
+#define SENSOR_SCALE_SHIFT         22   // Formato Q22: raw * escala cabe em 32 bits para spans de até 12 bits
+#define SENSOR_Q4_FRAC_BITS        4    // Leituras filtradas em Q4 (12 bits inteiros + 4 fracionários)
+
+typedef struct {
+    uint16_t raw_min;   // Leitura correspondente a 0
+    uint16_t raw_max;   // Leitura correspondente a 1000 (100,0%)
+    uint16_t span;      // raw_max - raw_min
+    uint32_t scale_q22; // ceil(1000 * 2^22 / span)
+    uint32_t scale_q18; // ceil(1000 * 2^18 / span), para entradas em Q4
+} sensor_convert_t;
+
+void sensor_convert_init(sensor_convert_t *conv, uint16_t raw_min, uint16_t raw_max);
+uint16_t sensor_convert_permille(const sensor_convert_t *conv, uint16_t raw);
+uint16_t sensor_convert_permille_q4(const sensor_convert_t *conv, uint16_t value_q4);
+uint8_t sensor_permille_to_percent(uint16_t permille);
+
+#endif // SENSOR_CONVERT_H
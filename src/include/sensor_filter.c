@@ -0,0 +1,126 @@
+#include "sensor_filter.h"
+
+/**
+ * @brief Inicializa o filtro de um canal.
+ *
+ * @param f Filtro a ser inicializado.
+ * @param mode SENSOR_FILTER_BOXCAR ou SENSOR_FILTER_IIR.
+ * @param osr_log2 Log2 da razão de sobreamostragem (uma saída a cada 2^osr_log2 amostras).
+ * @param iir_shift Constante de tempo do modo IIR (ignorada no modo boxcar).
+ */
+void sensor_filter_init(sensor_filter_t *f, sensor_filter_mode_t mode, uint8_t osr_log2, uint8_t iir_shift) {
+    if (osr_log2 > SENSOR_FILTER_MAX_OSR_LOG2) osr_log2 = SENSOR_FILTER_MAX_OSR_LOG2;
+    if (iir_shift > SENSOR_FILTER_MAX_IIR_SHIFT) iir_shift = SENSOR_FILTER_MAX_IIR_SHIFT;
+
+    f->mode = mode;
+    f->osr_log2 = osr_log2;
+    f->iir_shift = iir_shift;
+    f->primed = false;
+    f->count = 0;
+    f->acc = 0;
+    sensor_filter_reset_stats(f);
+}
+
+/**
+ * @brief Entrega uma amostra crua ao filtro.
+ *
+ * @param f Filtro do canal.
+ * @param raw Amostra crua de 12 bits.
+ * @param out_q4 Recebe a saída decimada em Q4 quando a função retorna true.
+ * @return true se uma nova saída foi produzida.
+ */
+bool sensor_filter_push(sensor_filter_t *f, uint16_t raw, uint16_t *out_q4) {
+    f->samples_in++;
+
+    if (f->mode == SENSOR_FILTER_IIR) {
+        uint32_t x = (uint32_t)raw << SENSOR_FILTER_OUT_FRAC_BITS;
+        if (!f->primed) {
+            // Evita a rampa de partida começando o estado na primeira leitura
+            f->acc = x << f->iir_shift;
+            f->primed = true;
+        } else {
+            f->acc = f->acc - (f->acc >> f->iir_shift) + x;
+        }
+    } else {
+        f->acc += raw;
+    }
+
+    if (++f->count < (1u << f->osr_log2)) {
+        return false;
+    }
+    f->count = 0;
+    f->outputs++;
+
+    if (f->mode == SENSOR_FILTER_IIR) {
+        *out_q4 = (uint16_t)(f->acc >> f->iir_shift);
+    } else {
+        // Soma de 2^n amostras -> Q4: desloca por (4 - n), com arredondamento quando n > 4
+        if (f->osr_log2 <= SENSOR_FILTER_OUT_FRAC_BITS) {
+            *out_q4 = (uint16_t)(f->acc << (SENSOR_FILTER_OUT_FRAC_BITS - f->osr_log2));
+        } else {
+            uint8_t shift = (uint8_t)(f->osr_log2 - SENSOR_FILTER_OUT_FRAC_BITS);
+            *out_q4 = (uint16_t)((f->acc + (1u << (shift - 1))) >> shift);
+        }
+        f->acc = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Filtra um canal de um bloco intercalado.
+ *
+ * @param f Filtro do canal.
+ * @param samples Primeira amostra do canal dentro do bloco.
+ * @param count Número de amostras do canal no bloco.
+ * @param stride Distância entre amostras consecutivas do canal (número de canais intercalados).
+ * @param out_q4 Vetor com espaço para até `count` saídas.
+ * @param out_index Opcional (pode ser NULL): posição, dentro do bloco, da amostra que gerou cada saída.
+ * @return Número de saídas decimadas escritas em out_q4.
+ */
+uint16_t sensor_filter_process(sensor_filter_t *f, const uint16_t *samples, uint16_t count, uint8_t stride,
+                               uint16_t *out_q4, uint16_t *out_index) {
+    uint16_t produced = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (sensor_filter_push(f, samples[(uint32_t)i * stride], &out_q4[produced])) {
+            if (out_index != NULL) {
+                out_index[produced] = i;
+            }
+            produced++;
+        }
+    }
+    return produced;
+}
+
+/**
+ * @brief Bits efetivos ganhos pela sobreamostragem (meio bit por oitava, limitado ao formato Q4).
+ */
+uint8_t sensor_filter_extra_bits(const sensor_filter_t *f) {
+    uint8_t bits = (uint8_t)(f->osr_log2 / 2);
+    return bits > SENSOR_FILTER_OUT_FRAC_BITS ? SENSOR_FILTER_OUT_FRAC_BITS : bits;
+}
+
+/**
+ * @brief Registra o tempo gasto pelo chamador filtrando as amostras entregues desde a última chamada.
+ */
+void sensor_filter_account(sensor_filter_t *f, uint32_t elapsed_us) {
+    f->busy_us += elapsed_us;
+}
+
+/**
+ * @brief Custo médio por amostra de entrada em ciclos de CPU.
+ *
+ * @param f Filtro do canal.
+ * @param cpu_mhz Frequência da CPU em MHz.
+ */
+uint32_t sensor_filter_cycles_per_sample(const sensor_filter_t *f, uint32_t cpu_mhz) {
+    if (f->samples_in == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)f->busy_us * cpu_mhz) / f->samples_in);
+}
+
+void sensor_filter_reset_stats(sensor_filter_t *f) {
+    f->samples_in = 0;
+    f->outputs = 0;
+    f->busy_us = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Estágio de sobreamostragem e decimação entre a captura do ADC e o processamento.
+// Trabalha só com inteiros e mantém estado constante por canal. A saída é sempre
+// em Q4 (leitura de 12 bits << 4), o que acomoda até 4 bits extras efetivos.
+
+#define SENSOR_FILTER_OUT_FRAC_BITS 4
+#define SENSOR_FILTER_MAX_OSR_LOG2  8   // Soma de 256 amostras de 12 bits cabe folgada em 32 bits
+#define SENSOR_FILTER_MAX_IIR_SHIFT 15  // Acumulador Q4 << 15 ainda cabe em 32 bits
+
+typedef enum {
+    SENSOR_FILTER_BOXCAR, // Média em blocos de 2^osr_log2 amostras (CIC de 1ª ordem)
+    SENSOR_FILTER_IIR     // Passa-baixa exponencial (alpha = 1/2^iir_shift), decimado por 2^osr_log2
+} sensor_filter_mode_t;
+
+typedef struct {
+    sensor_filter_mode_t mode;
+    uint8_t osr_log2;     // Razão de decimação = 2^osr_log2
+    uint8_t iir_shift;    // Constante do passa-baixa no modo IIR
+    bool primed;          // IIR já recebeu a primeira amostra
+    uint16_t count;       // Amostras acumuladas desde a última saída
+    uint32_t acc;         // Soma (boxcar) ou estado Q4 << iir_shift (IIR)
+    // Custo medido pelo chamador (ver sensor_filter_account)
+    uint32_t samples_in;
+    uint32_t outputs;
+    uint32_t busy_us;
+} sensor_filter_t;
+
+void sensor_filter_init(sensor_filter_t *f, sensor_filter_mode_t mode, uint8_t osr_log2, uint8_t iir_shift);
+bool sensor_filter_push(sensor_filter_t *f, uint16_t raw, uint16_t *out_q4);
+uint16_t sensor_filter_process(sensor_filter_t *f, const uint16_t *samples, uint16_t count, uint8_t stride,
+                               uint16_t *out_q4, uint16_t *out_index);
+uint8_t sensor_filter_extra_bits(const sensor_filter_t *f);
+
+void sensor_filter_account(sensor_filter_t *f, uint32_t elapsed_us);
+uint32_t sensor_filter_cycles_per_sample(const sensor_filter_t *f, uint32_t cpu_mhz);
+void sensor_filter_reset_stats(sensor_filter_t *f);
+
+#endif // SENSOR_FILTER_H
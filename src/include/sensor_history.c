@@ -0,0 +1,223 @@
+#include "sensor_history.h"
+
+// Baldes da janela anterior resumidos em um balde da janela seguinte
+static const uint8_t history_fan_in[HISTORY_SPAN_COUNT - 1] = { 10, 6 };
+
+// Duração de um balde de cada janela, em segundos
+static const uint8_t history_bucket_seconds[HISTORY_SPAN_COUNT] = { 1, 10, 60 };
+
+static inline uint8_t history_bin(uint16_t value) {
+    return (uint8_t)(value >> HISTORY_HIST_SHIFT);
+}
+
+static void acc_reset(history_acc_t *acc) {
+    acc->min = 0;
+    acc->max = 0;
+    acc->sum = 0;
+    acc->count = 0;
+}
+
+static void acc_add(history_acc_t *acc, uint16_t min, uint16_t max, uint16_t mean) {
+    if (acc->count == 0 || min < acc->min) acc->min = min;
+    if (acc->count == 0 || max > acc->max) acc->max = max;
+    acc->sum += mean;
+    acc->count++;
+}
+
+static history_bucket_t acc_bucket(const history_acc_t *acc) {
+    history_bucket_t b = { acc->min, acc->max, (uint16_t)(acc->sum / acc->count) };
+    return b;
+}
+
+static inline uint8_t deque_front(const history_deque_t *q) {
+    return q->pos[q->head];
+}
+
+static inline uint8_t deque_back(const history_deque_t *q) {
+    return q->pos[(q->head + q->count - 1) % HISTORY_WINDOW_SLOTS];
+}
+
+static inline void deque_pop_front(history_deque_t *q) {
+    q->head = (uint8_t)((q->head + 1) % HISTORY_WINDOW_SLOTS);
+    q->count--;
+}
+
+static inline void deque_push_back(history_deque_t *q, uint8_t pos) {
+    q->pos[(q->head + q->count) % HISTORY_WINDOW_SLOTS] = pos;
+    q->count++;
+}
+
+/**
+ * @brief Insere um balde na janela em O(1) amortizado.
+ *        O balde mais antigo (na posição de escrita) sai da soma, do histograma e
+ *        da frente das deques; as deques descartam pelo fundo os baldes que nunca
+ *        mais poderão ser mínimo/máximo enquanto o novo estiver na janela.
+ */
+static void window_push(history_window_t *w, history_bucket_t bucket) {
+    uint8_t pos = w->write_pos;
+
+    if (w->filled == HISTORY_WINDOW_SLOTS) {
+        const history_bucket_t *old = &w->slots[pos];
+        w->sum -= old->mean;
+        w->hist[history_bin(old->mean)]--;
+        if (w->min_q.count && deque_front(&w->min_q) == pos) deque_pop_front(&w->min_q);
+        if (w->max_q.count && deque_front(&w->max_q) == pos) deque_pop_front(&w->max_q);
+    } else {
+        w->filled++;
+    }
+
+    w->slots[pos] = bucket;
+    w->sum += bucket.mean;
+    w->hist[history_bin(bucket.mean)]++;
+
+    while (w->min_q.count && w->slots[deque_back(&w->min_q)].min >= bucket.min) w->min_q.count--;
+    deque_push_back(&w->min_q, pos);
+    while (w->max_q.count && w->slots[deque_back(&w->max_q)].max <= bucket.max) w->max_q.count--;
+    deque_push_back(&w->max_q, pos);
+
+    w->write_pos = (uint8_t)((pos + 1) % HISTORY_WINDOW_SLOTS);
+}
+
+/**
+ * @brief Inicializa o histórico vazio.
+ *
+ * @param h Histórico.
+ * @param samples_per_second Taxa com que sensor_history_push() é chamada.
+ */
+void sensor_history_init(sensor_history_t *h, uint16_t samples_per_second) {
+    for (uint8_t s = 0; s < HISTORY_SPAN_COUNT; ++s) {
+        history_window_t *w = &h->windows[s];
+        w->min_q.head = w->min_q.count = 0;
+        w->max_q.head = w->max_q.count = 0;
+        w->write_pos = 0;
+        w->filled = 0;
+        w->sum = 0;
+        for (uint8_t b = 0; b < HISTORY_HIST_BINS; ++b) {
+            w->hist[b] = 0;
+        }
+        acc_reset(&w->acc);
+    }
+    acc_reset(&h->second);
+    h->samples_per_second = samples_per_second ? samples_per_second : 1;
+}
+
+/**
+ * @brief Registra uma leitura. A cada segundo completo o balde de 1 s entra na
+ *        janela de 1 min e, em cascata, alimenta as janelas mais longas.
+ *
+ * @param h Histórico.
+ * @param value Leitura (ex.: permilagem 0-1000); saturada em HISTORY_VALUE_MAX.
+ */
+void sensor_history_push(sensor_history_t *h, uint16_t value) {
+    if (value > HISTORY_VALUE_MAX) value = HISTORY_VALUE_MAX;
+
+    acc_add(&h->second, value, value, value);
+    if (h->second.count < h->samples_per_second) {
+        return;
+    }
+
+    history_bucket_t bucket = acc_bucket(&h->second);
+    acc_reset(&h->second);
+
+    for (uint8_t s = 0; s < HISTORY_SPAN_COUNT; ++s) {
+        history_window_t *w = &h->windows[s];
+        window_push(w, bucket);
+        if (s == HISTORY_SPAN_COUNT - 1) {
+            break;
+        }
+
+        acc_add(&w->acc, bucket.min, bucket.max, bucket.mean);
+        if (w->acc.count < history_fan_in[s]) {
+            break;
+        }
+        bucket = acc_bucket(&w->acc);
+        acc_reset(&w->acc);
+    }
+}
+
+/**
+ * @brief Percentil das médias dos baldes da janela, com resolução de um bin do
+ *        histograma, limitado ao mínimo e máximo da janela.
+ *
+ * @return Valor do percentil ou 0 se a janela estiver vazia.
+ */
+uint16_t sensor_history_percentile(const sensor_history_t *h, history_span_t span, uint8_t percent) {
+    const history_window_t *w = &h->windows[span];
+    if (w->filled == 0) {
+        return 0;
+    }
+    if (percent > 100) percent = 100;
+
+    // Posição (1..filled) do percentil pelo método do posto mais próximo
+    uint16_t rank = (uint16_t)((w->filled * percent + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint16_t cumulative = 0;
+    uint8_t bin = 0;
+    for (; bin < HISTORY_HIST_BINS - 1; ++bin) {
+        cumulative += w->hist[bin];
+        if (cumulative >= rank) {
+            break;
+        }
+    }
+
+    uint16_t value = (uint16_t)((bin << HISTORY_HIST_SHIFT) + (1u << (HISTORY_HIST_SHIFT - 1)));
+    uint16_t lo = w->slots[deque_front(&w->min_q)].min;
+    uint16_t hi = w->slots[deque_front(&w->max_q)].max;
+    if (value < lo) value = lo;
+    if (value > hi) value = hi;
+    return value;
+}
+
+/**
+ * @brief Resumo de uma janela: mínimo e máximo (frente das deques), média
+ *        (soma corrente) e percentis 50 e 90. Mínimo, máximo e média incluem
+ *        também as leituras que ainda não fecharam um balde desta janela (o
+ *        segundo em formação e os acumuladores das janelas mais curtas), então
+ *        refletem até a leitura mais recente. Os percentis usam só baldes completos.
+ *
+ * @return false se nenhuma leitura foi registrada.
+ */
+bool sensor_history_summary(const sensor_history_t *h, history_span_t span, history_summary_t *out) {
+    const history_window_t *w = &h->windows[span];
+    uint32_t sps = h->samples_per_second;
+
+    // Média ponderada pelo tempo, em leituras: cada balde de b segundos pesa b * sps
+    uint64_t weighted = 0;
+    uint32_t weight = 0;
+    bool any = false;
+    if (w->filled > 0) {
+        out->min = w->slots[deque_front(&w->min_q)].min;
+        out->max = w->slots[deque_front(&w->max_q)].max;
+        weighted = (uint64_t)w->sum * history_bucket_seconds[span] * sps;
+        weight = (uint32_t)w->filled * history_bucket_seconds[span] * sps;
+        any = true;
+    }
+
+    // Baldes das janelas mais curtas ainda não resumidos para esta, e o segundo atual
+    for (uint8_t s = 0; s <= (uint8_t)span; ++s) {
+        const history_acc_t *acc = (s == 0) ? &h->second : &h->windows[s - 1].acc;
+        if (acc->count == 0) {
+            continue;
+        }
+        if (!any || acc->min < out->min) out->min = acc->min;
+        if (!any || acc->max > out->max) out->max = acc->max;
+        uint32_t scale = (s == 0) ? 1u : history_bucket_seconds[s - 1] * sps;
+        weighted += (uint64_t)acc->sum * scale;
+        weight += acc->count * scale;
+        any = true;
+    }
+    if (!any) {
+        return false;
+    }
+
+    out->mean = (uint16_t)(weighted / weight);
+    if (w->filled > 0) {
+        out->p50 = sensor_history_percentile(h, span, 50);
+        out->p90 = sensor_history_percentile(h, span, 90);
+    } else {
+        out->p50 = out->p90 = out->mean;
+    }
+    out->seconds = (uint16_t)(weight / sps);
+    return true;
+}
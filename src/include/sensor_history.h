@@ -0,0 +1,83 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Histórico de um sensor com pegada fixa: mínimo, máximo, média e percentis
+// em janelas de 1 min, 10 min e 1 h.
+//
+// As leituras são agregadas em baldes de 1 s; cada janela é um anel de
+// HISTORY_WINDOW_SLOTS baldes, e a janela seguinte recebe um balde resumindo
+// 10 (e depois 6) baldes da anterior (1 s -> 10 s -> 60 s). Cada janela mantém
+// deques monotônicas para mínimo e máximo, a soma das médias e um histograma
+// das médias, de modo que inserir custa O(1) amortizado e consultar mínimo,
+// máximo e média custa O(1). Os percentis percorrem o histograma
+// (HISTORY_HIST_BINS posições) e têm a resolução de um bin.
+// Não depende do Pico SDK nem do FreeRTOS.
+
+#define HISTORY_WINDOW_SLOTS 60   // Baldes por janela
+#define HISTORY_HIST_SHIFT   4    // Bin do histograma = valor >> 4 (16 permilagem)
+#define HISTORY_HIST_BINS    64   // Cobre 0..1023
+#define HISTORY_VALUE_MAX    ((HISTORY_HIST_BINS << HISTORY_HIST_SHIFT) - 1)
+
+typedef enum {
+    HISTORY_SPAN_1MIN,  // 60 baldes de 1 s
+    HISTORY_SPAN_10MIN, // 60 baldes de 10 s
+    HISTORY_SPAN_1H,    // 60 baldes de 60 s
+    HISTORY_SPAN_COUNT
+} history_span_t;
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;
+} history_bucket_t;
+
+// Acumulador de um balde em formação
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+    uint16_t count;
+} history_acc_t;
+
+// Deque monotônica de posições do anel, em ordem de inserção
+typedef struct {
+    uint8_t pos[HISTORY_WINDOW_SLOTS];
+    uint8_t head;
+    uint8_t count;
+} history_deque_t;
+
+typedef struct {
+    history_bucket_t slots[HISTORY_WINDOW_SLOTS];
+    history_deque_t min_q;       // Frente = índice do menor mínimo na janela
+    history_deque_t max_q;       // Frente = índice do maior máximo na janela
+    uint8_t write_pos;           // Próxima posição do anel (a mais antiga quando cheio)
+    uint8_t filled;              // Baldes válidos (satura em HISTORY_WINDOW_SLOTS)
+    uint32_t sum;                // Soma das médias dos baldes válidos
+    uint8_t hist[HISTORY_HIST_BINS];
+    history_acc_t acc;           // Balde da próxima janela em formação
+} history_window_t;
+
+typedef struct {
+    history_window_t windows[HISTORY_SPAN_COUNT];
+    history_acc_t second;        // Balde de 1 s em formação (leituras brutas)
+    uint16_t samples_per_second;
+} sensor_history_t;
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;
+    uint16_t p50;
+    uint16_t p90;
+    uint16_t seconds;  // Tempo efetivamente coberto pela janela
+} history_summary_t;
+
+void sensor_history_init(sensor_history_t *h, uint16_t samples_per_second);
+void sensor_history_push(sensor_history_t *h, uint16_t value);
+bool sensor_history_summary(const sensor_history_t *h, history_span_t span, history_summary_t *out);
+uint16_t sensor_history_percentile(const sensor_history_t *h, history_span_t span, uint8_t percent);
+
+#endif // SENSOR_HISTORY_H
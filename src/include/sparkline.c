@@ -0,0 +1,40 @@
+#include "sparkline.h"
+
+/**
+ * @brief Define a área do gráfico. Não desenha nada: a área começa como estiver
+ *        no buffer (normalmente limpa pelo primeiro quadro).
+ */
+void sparkline_init(sparkline_t *spark, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    spark->x = x;
+    spark->y = y;
+    spark->width = (width > 1) ? width : 2;
+    spark->height = (height > 1) ? height : 2;
+    spark->cursor = 0;
+}
+
+/**
+ * @brief Desenha a próxima amostra como uma barra na coluna do cursor e apaga a
+ *        coluna seguinte (exceto na volta ao início). A barra tem ao menos uma
+ *        linha, de modo que o trecho já varrido fica visível mesmo com valor 0.
+ *
+ * @param spark Gráfico.
+ * @param ssd Ponteiro para a estrutura de controle do display SSD1306.
+ * @param percent Valor da amostra (0-100; acima disso é saturado).
+ */
+void sparkline_push(sparkline_t *spark, ssd1306_t *ssd, uint8_t percent) {
+    if (percent > 100) percent = 100;
+
+    uint8_t bar = 1 + (uint8_t)(((uint16_t)percent * (spark->height - 1) + 50) / 100);
+    uint8_t column = spark->x + spark->cursor;
+    uint8_t bottom = spark->y + spark->height;
+
+    ssd1306_fill_rect(ssd, column, spark->y, 1, spark->height - bar, false);
+    ssd1306_fill_rect(ssd, column, bottom - bar, 1, bar, true);
+
+    // Na volta ao início a coluna seguinte fica longe desta e a janela suja da
+    // página cobriria o gráfico inteiro: o espaço do cursor é pulado nessa amostra
+    spark->cursor = (uint8_t)((spark->cursor + 1) % spark->width);
+    if (spark->cursor != 0) {
+        ssd1306_fill_rect(ssd, spark->x + spark->cursor, spark->y, 1, spark->height, false);
+    }
+}
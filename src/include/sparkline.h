@@ -0,0 +1,28 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lib/ssd1306/ssd1306.h"
+
+// Gráfico de histórico em varredura (estilo osciloscópio) para o SSD1306.
+// Cada nova amostra vira uma barra em uma única coluna, escrita na posição do
+// cursor; a coluna seguinte é apagada para marcar o "agora". Ao chegar à borda
+// direita o cursor volta ao início e sobrescreve as colunas mais antigas.
+// Nada é deslocado no buffer, então o controle de regiões sujas do driver envia
+// só as duas colunas tocadas por amostra em vez da área inteira do gráfico.
+// Com o gráfico dentro de uma página (altura <= 8 e sem cruzar a borda da
+// página) cada coluna é um único byte no barramento.
+
+typedef struct {
+    uint8_t x;              // Primeira coluna da área
+    uint8_t y;              // Linha superior da área
+    uint8_t width;          // Colunas (= amostras visíveis)
+    uint8_t height;         // Linhas
+    uint8_t cursor;         // Coluna (relativa a x) da próxima amostra
+} sparkline_t;
+
+void sparkline_init(sparkline_t *spark, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void sparkline_push(sparkline_t *spark, ssd1306_t *ssd, uint8_t percent);
+
+#endif // SPARKLINE_H
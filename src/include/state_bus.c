@@ -0,0 +1,279 @@
+#include "state_bus.h"
+
+// Snapshot compartilhado: escrito só pelo produtor, lido por qualquer inscrito
+static AlertStatus_t bus_snapshot;
+static uint32_t bus_published_us;
+static volatile uint32_t bus_seq; // Ímpar enquanto o produtor escreve
+
+static TaskHandle_t bus_subscribers[STATE_BUS_MAX_SUBSCRIBERS];
+static state_bus_deadband_t bus_deadbands[STATE_BUS_MAX_SUBSCRIBERS];
+static state_bus_filter_t bus_filters[STATE_BUS_MAX_SUBSCRIBERS];
+static AlertStatus_t bus_last_delivered[STATE_BUS_MAX_SUBSCRIBERS]; // Escrito só pelo produtor
+static uint8_t bus_subscriber_count;
+
+// Estatísticas por inscrito: cada contador tem um único escritor
+static uint32_t sub_last_seq[STATE_BUS_MAX_SUBSCRIBERS];
+static uint32_t sub_wake_us_max[STATE_BUS_MAX_SUBSCRIBERS];
+static uint32_t sub_read_retries[STATE_BUS_MAX_SUBSCRIBERS];
+static uint32_t sub_delivered[STATE_BUS_MAX_SUBSCRIBERS];  // Escrito só pelo produtor
+static uint32_t sub_suppressed[STATE_BUS_MAX_SUBSCRIBERS]; // Escrito só pelo produtor
+static uint32_t sub_applied[STATE_BUS_MAX_SUBSCRIBERS];
+static uint32_t sub_e2e_us_total[STATE_BUS_MAX_SUBSCRIBERS];
+static uint32_t sub_e2e_us_max[STATE_BUS_MAX_SUBSCRIBERS];
+
+// Estatísticas do produtor
+static uint32_t bus_publishes;
+static uint32_t bus_publish_us_total;
+static uint32_t bus_publish_us_max;
+
+// Zona morta aplicada quando o inscrito não informa uma: qualquer mudança acorda
+static const state_bus_deadband_t bus_any_change = { 0, 0, 0, 0, 0 };
+
+// |a - b| > deadband; STATE_BUS_IGNORE desativa o campo
+static inline bool exceeds_deadband(int32_t a, int32_t b, uint16_t deadband) {
+    int32_t delta = a - b;
+    if (delta < 0) delta = -delta;
+    return deadband != STATE_BUS_IGNORE && delta > (int32_t)deadband;
+}
+
+// Decide se o inscrito `i` deve ser acordado pelo estado `status`
+static bool state_bus_is_relevant(uint8_t i, const AlertStatus_t *status) {
+    const AlertStatus_t *last = &bus_last_delivered[i];
+    const state_bus_deadband_t *db = &bus_deadbands[i];
+
+    if (status->level != last->level || status->severity != last->severity ||
+        status->is_alert_active != last->is_alert_active) {
+        return true;
+    }
+    return exceeds_deadband(status->water_level_percent, last->water_level_percent, db->water_percent) ||
+           exceeds_deadband(status->rain_volume_percent, last->rain_volume_percent, db->rain_percent) ||
+           exceeds_deadband(status->water_rise_per_min, last->water_rise_per_min, db->rise_per_min) ||
+           exceeds_deadband(status->seconds_to_threshold, last->seconds_to_threshold, db->seconds_to_threshold) ||
+           exceeds_deadband(status->water_max_1h_percent, last->water_max_1h_percent, db->water_max_1h_percent) ||
+           (bus_filters[i] != NULL && bus_filters[i](last, status));
+}
+
+/**
+ * @brief Inicializa o barramento com um estado conhecido.
+ *        Deve ser chamada antes de vTaskStartScheduler().
+ */
+void state_bus_init(const AlertStatus_t *initial) {
+    bus_snapshot = *initial;
+    bus_published_us = time_us_32();
+    bus_seq = 0;
+    bus_subscriber_count = 0;
+    bus_publishes = 0;
+    bus_publish_us_total = 0;
+    bus_publish_us_max = 0;
+}
+
+/**
+ * @brief Inscreve uma tarefa para ser notificada nas publicações relevantes para ela.
+ *        Deve ser chamada antes de vTaskStartScheduler(), pois a lista de
+ *        inscritos é lida pelo produtor sem trava.
+ *
+ * @param task Tarefa a ser notificada.
+ * @param deadband Zonas mortas por campo (NULL = acordar a cada mudança de qualquer campo).
+ * @return Identificador do inscrito ou -1 se a tabela estiver cheia.
+ */
+state_bus_sub_t state_bus_subscribe(TaskHandle_t task, const state_bus_deadband_t *deadband) {
+    if (task == NULL || bus_subscriber_count >= STATE_BUS_MAX_SUBSCRIBERS) {
+        return -1;
+    }
+
+    state_bus_sub_t sub = (state_bus_sub_t)bus_subscriber_count;
+    bus_subscribers[sub] = task;
+    bus_deadbands[sub] = (deadband != NULL) ? *deadband : bus_any_change;
+    bus_filters[sub] = NULL;
+    bus_last_delivered[sub] = bus_snapshot; // O inscrito parte do estado inicial
+    sub_delivered[sub] = 0;
+    sub_suppressed[sub] = 0;
+    sub_applied[sub] = 0;
+    sub_e2e_us_total[sub] = 0;
+    sub_e2e_us_max[sub] = 0;
+    sub_last_seq[sub] = bus_seq;
+    sub_wake_us_max[sub] = 0;
+    sub_read_retries[sub] = 0;
+    bus_subscriber_count++;
+    return sub;
+}
+
+/**
+ * @brief Acrescenta um filtro de relevância às zonas mortas do inscrito: ele também
+ *        é acordado quando `filter` indica uma mudança visível. Como a inscrição,
+ *        deve ser chamada antes de vTaskStartScheduler().
+ *
+ * @param sub Identificador retornado por state_bus_subscribe().
+ * @param filter Filtro (NULL remove).
+ */
+void state_bus_set_filter(state_bus_sub_t sub, state_bus_filter_t filter) {
+    if (sub < 0 || sub >= (state_bus_sub_t)bus_subscriber_count) {
+        return;
+    }
+    bus_filters[sub] = filter;
+}
+
+/**
+ * @brief Publica um novo estado e notifica os inscritos para os quais ele é relevante.
+ *        Apenas um produtor pode chamar esta função.
+ */
+void state_bus_publish(const AlertStatus_t *status) {
+    uint32_t start_us = time_us_32();
+
+    bus_seq++; // Ímpar: escrita em andamento
+    __sync_synchronize();
+    bus_snapshot = *status;
+    bus_published_us = start_us;
+    __sync_synchronize();
+    bus_seq++; // Par: snapshot consistente
+
+    for (uint8_t i = 0; i < bus_subscriber_count; ++i) {
+        if (state_bus_is_relevant(i, status)) {
+            bus_last_delivered[i] = *status;
+            sub_delivered[i]++;
+            xTaskNotifyGiveIndexed(bus_subscribers[i], STATE_BUS_NOTIFY_INDEX);
+        } else {
+            sub_suppressed[i]++;
+        }
+    }
+
+    uint32_t elapsed_us = time_us_32() - start_us;
+    bus_publishes++;
+    bus_publish_us_total += elapsed_us;
+    if (elapsed_us > bus_publish_us_max) {
+        bus_publish_us_max = elapsed_us;
+    }
+}
+
+/**
+ * @brief Bloqueia a tarefa atual até a próxima publicação ou até o timeout.
+ *        Publicações acumuladas durante o processamento acordam uma única vez.
+ *
+ * @return true se houve publicação, false em caso de timeout.
+ */
+bool state_bus_wait(TickType_t timeout) {
+    return ulTaskNotifyTakeIndexed(STATE_BUS_NOTIFY_INDEX, pdTRUE, timeout) > 0;
+}
+
+/**
+ * @brief Acorda um inscrito sem publicar (ex.: passo de animação ou mudança local
+ *        de configuração que exige redesenhar a saída). Ele relê o estado atual
+ *        como em uma publicação.
+ */
+void state_bus_wake(state_bus_sub_t sub) {
+    if (sub < 0 || sub >= (state_bus_sub_t)bus_subscriber_count) {
+        return;
+    }
+    xTaskNotifyGiveIndexed(bus_subscribers[sub], STATE_BUS_NOTIFY_INDEX);
+}
+
+/**
+ * @brief Versão de state_bus_wake() para uso em interrupções.
+ */
+void state_bus_wake_from_isr(state_bus_sub_t sub, BaseType_t *higher_priority_woken) {
+    if (sub < 0 || sub >= (state_bus_sub_t)bus_subscriber_count) {
+        return;
+    }
+    vTaskNotifyGiveIndexedFromISR(bus_subscribers[sub], STATE_BUS_NOTIFY_INDEX, higher_priority_woken);
+}
+
+/**
+ * @brief Copia o estado mais recente de forma consistente (leitor do seqlock).
+ *
+ * @param sub Identificador retornado por state_bus_subscribe() (ou -1 para leitura avulsa).
+ * @param out Destino da cópia.
+ * @return Número da publicação lida (0 = estado inicial).
+ */
+uint32_t state_bus_read(state_bus_sub_t sub, AlertStatus_t *out) {
+    uint32_t seq_begin;
+    uint32_t published_us;
+    uint32_t retries = 0;
+
+    while (true) {
+        seq_begin = bus_seq;
+        if ((seq_begin & 1u) == 0) {
+            __sync_synchronize();
+            *out = bus_snapshot;
+            published_us = bus_published_us;
+            __sync_synchronize();
+            if (bus_seq == seq_begin) {
+                break;
+            }
+        }
+        retries++;
+    }
+
+    if (sub >= 0 && sub < (state_bus_sub_t)bus_subscriber_count) {
+        sub_read_retries[sub] += retries;
+        if (seq_begin != sub_last_seq[sub]) {
+            uint32_t wake_us = time_us_32() - published_us;
+            if (wake_us > sub_wake_us_max[sub]) {
+                sub_wake_us_max[sub] = wake_us;
+            }
+            sub_last_seq[sub] = seq_begin;
+        }
+    }
+    return seq_begin >> 1;
+}
+
+/**
+ * @brief Agrega as estatísticas do produtor e dos inscritos desde o boot. Só leitura:
+ *        os inscritos atualizam seus contadores em outras tarefas (e no outro núcleo),
+ *        então um reset daqui poderia se intercalar com um incremento e perdê-lo.
+ *
+ * @param out Destino.
+ */
+void state_bus_get_stats(state_bus_stats_t *out) {
+    out->publishes = bus_publishes;
+    out->publish_us_total = bus_publish_us_total;
+    out->publish_us_max = bus_publish_us_max;
+    out->wake_us_max = 0;
+    out->read_retries = 0;
+    out->delivered = 0;
+    out->suppressed = 0;
+    out->applied = 0;
+    out->e2e_us_total = 0;
+    out->e2e_us_max = 0;
+    for (uint8_t i = 0; i < bus_subscriber_count; ++i) {
+        if (sub_wake_us_max[i] > out->wake_us_max) {
+            out->wake_us_max = sub_wake_us_max[i];
+        }
+        out->read_retries += sub_read_retries[i];
+        out->delivered += sub_delivered[i];
+        out->suppressed += sub_suppressed[i];
+        out->applied += sub_applied[i];
+        out->e2e_us_total += sub_e2e_us_total[i];
+        if (sub_e2e_us_max[i] > out->e2e_us_max) {
+            out->e2e_us_max = sub_e2e_us_max[i];
+        }
+    }
+}
+
+/**
+ * @brief Registra que o inscrito aplicou `status` às suas saídas e mede a latência
+ *        fim a fim desde a leitura do sensor (AlertStatus_t.sample_timestamp_us).
+ */
+void state_bus_note_applied(state_bus_sub_t sub, const AlertStatus_t *status) {
+    if (sub < 0 || sub >= (state_bus_sub_t)bus_subscriber_count) {
+        return;
+    }
+    uint32_t e2e_us = time_us_32() - status->sample_timestamp_us;
+    sub_applied[sub]++;
+    sub_e2e_us_total[sub] += e2e_us;
+    if (e2e_us > sub_e2e_us_max[sub]) {
+        sub_e2e_us_max[sub] = e2e_us;
+    }
+}
+
+/**
+ * @brief Contadores de entregas e supressões de um inscrito desde o boot.
+ */
+void state_bus_get_sub_counts(state_bus_sub_t sub, uint32_t *delivered, uint32_t *suppressed) {
+    if (sub < 0 || sub >= (state_bus_sub_t)bus_subscriber_count) {
+        *delivered = 0;
+        *suppressed = 0;
+        return;
+    }
+    *delivered = sub_delivered[sub];
+    *suppressed = sub_suppressed[sub];
+}
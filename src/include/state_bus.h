@@ -0,0 +1,74 @@
+#ifndef STATE_BUS_H
+#define STATE_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Barramento de estado publish/subscribe sem cópias por consumidor.
+//
+// Um único produtor (vDataProcessingTask) publica o AlertStatus_t mais recente em
+// um snapshot compartilhado protegido por seqlock: o contador de sequência fica
+// ímpar durante a escrita e o leitor repete a cópia se o contador mudou no meio.
+// Cada inscrito é acordado por notificação direta à tarefa no índice
+// STATE_BUS_NOTIFY_INDEX, então um consumidor novo não custa fila nem heap.
+// Semântica de "último valor": um consumidor lento perde estados intermediários,
+// mas sempre lê o mais recente, como ocorria quando as filas enchiam.
+//
+// Despacho por mudança: cada inscrito informa uma zona morta por campo e só é
+// acordado quando nível, severidade ou flag de alerta mudam, ou quando algum
+// campo se afasta do último valor entregue a ele por mais que a zona morta.
+// Quando a relevância não cabe em uma zona morta (ex.: degraus da matriz), o
+// inscrito pode registrar um filtro próprio com state_bus_set_filter().
+
+#define STATE_BUS_MAX_SUBSCRIBERS 6
+#define STATE_BUS_NOTIFY_INDEX    1 // Índice 0 fica livre para notificações de E/S (ex.: adc_capture)
+
+typedef int8_t state_bus_sub_t; // Identificador do inscrito; negativo = inscrição falhou
+
+#define STATE_BUS_IGNORE 0xFFFFu // Zona morta que nunca dispara: o inscrito não usa o campo
+
+// Variação (estritamente maior) que acorda o inscrito, por campo de AlertStatus_t
+typedef struct {
+    uint16_t water_percent;
+    uint16_t rain_percent;
+    uint16_t rise_per_min;
+    uint16_t seconds_to_threshold;
+    uint16_t water_max_1h_percent;
+} state_bus_deadband_t;
+
+// Filtro de relevância extra, avaliado pelo produtor em state_bus_publish():
+// retorna true se `status` difere de `last` (o último estado entregue) de um jeito
+// que o inscrito exibe. Deve ser curto e não pode bloquear nem tocar no estado da tarefa inscrita.
+typedef bool (*state_bus_filter_t)(const AlertStatus_t *last, const AlertStatus_t *status);
+
+// Contadores desde o boot. Cada um tem um único escritor (o produtor ou a tarefa
+// inscrita), então ninguém os zera: quem lê calcula a diferença entre duas leituras.
+typedef struct {
+    uint32_t publishes;         // Publicações
+    uint32_t publish_us_total;  // Tempo acumulado dentro de state_bus_publish()
+    uint32_t publish_us_max;    // Pior publicação desde o boot
+    uint32_t wake_us_max;       // Pior atraso entre publicar e um inscrito ler, desde o boot
+    uint32_t read_retries;      // Leituras repetidas por colisão com o produtor
+    uint32_t delivered;         // Notificações enviadas (soma dos inscritos)
+    uint32_t suppressed;        // Publicações filtradas pelas zonas mortas (soma dos inscritos)
+    uint32_t applied;           // Estados aplicados às saídas (state_bus_note_applied)
+    uint32_t e2e_us_total;      // Soma das latências leitura do sensor -> saída aplicada
+    uint32_t e2e_us_max;        // Pior latência fim a fim desde o boot
+} state_bus_stats_t;
+
+void state_bus_init(const AlertStatus_t *initial);
+state_bus_sub_t state_bus_subscribe(TaskHandle_t task, const state_bus_deadband_t *deadband);
+void state_bus_set_filter(state_bus_sub_t sub, state_bus_filter_t filter);
+void state_bus_publish(const AlertStatus_t *status);
+bool state_bus_wait(TickType_t timeout);
+void state_bus_wake(state_bus_sub_t sub);
+void state_bus_wake_from_isr(state_bus_sub_t sub, BaseType_t *higher_priority_woken);
+uint32_t state_bus_read(state_bus_sub_t sub, AlertStatus_t *out);
+void state_bus_get_stats(state_bus_stats_t *out);
+void state_bus_note_applied(state_bus_sub_t sub, const AlertStatus_t *status);
+void state_bus_get_sub_counts(state_bus_sub_t sub, uint32_t *delivered, uint32_t *suppressed);
+
+#endif // STATE_BUS_H
@@ -0,0 +1,84 @@
+#include "text_format.h"
+
+/**
+ * @brief Começa uma linha vazia em `buf` (cap >= 1).
+ */
+void text_init(text_line_t *t, char *buf, uint8_t cap) {
+    t->buf = buf;
+    t->len = 0;
+    t->cap = cap;
+    buf[0] = '\0';
+}
+
+/**
+ * @brief Acrescenta um caractere (descartado se a linha estiver cheia).
+ */
+void text_char(text_line_t *t, char c) {
+    if (t->len + 1 < t->cap) {
+        t->buf[t->len++] = c;
+        t->buf[t->len] = '\0';
+    }
+}
+
+void text_str(text_line_t *t, const char *s) {
+    while (*s && t->len + 1 < t->cap) {
+        t->buf[t->len++] = *s++;
+    }
+    t->buf[t->len] = '\0';
+}
+
+// Dígitos de `value` em ordem inversa; retorna a quantidade
+static uint8_t text_digits(uint32_t value, char digits[10]) {
+    uint8_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return n;
+}
+
+/**
+ * @brief Acrescenta `value` em decimal, alinhado à direita em `width` colunas
+ *        (equivale a "%*u"; números mais largos ocupam o espaço necessário).
+ */
+void text_uint(text_line_t *t, uint32_t value, uint8_t width) {
+    char digits[10];
+    uint8_t n = text_digits(value, digits);
+    while (width > n) {
+        text_char(t, ' ');
+        width--;
+    }
+    while (n > 0) {
+        text_char(t, digits[--n]);
+    }
+}
+
+/**
+ * @brief Como text_uint, com sinal (equivale a "%*d").
+ */
+void text_int(text_line_t *t, int32_t value, uint8_t width) {
+    if (value >= 0) {
+        text_uint(t, (uint32_t)value, width);
+        return;
+    }
+    char digits[10];
+    uint8_t n = text_digits(0u - (uint32_t)value, digits);
+    while (width > n + 1) {
+        text_char(t, ' ');
+        width--;
+    }
+    text_char(t, '-');
+    while (n > 0) {
+        text_char(t, digits[--n]);
+    }
+}
+
+/**
+ * @brief Completa a linha com espaços até `width` caracteres (equivale a "%-*s").
+ */
+void text_pad(text_line_t *t, uint8_t width) {
+    while (t->len < width && t->len + 1 < t->cap) {
+        t->buf[t->len++] = ' ';
+    }
+    t->buf[t->len] = '\0';
+}
@@ -0,0 +1,27 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Formatação mínima de linhas de texto de largura fixa para o display.
+// Substitui sprintf/snprintf no caminho de desenho: só inteiros em decimal com
+// largura mínima (alinhados à direita com espaços), textos e preenchimento.
+// Escreve direto no buffer do chamador, sem heap e com pilha constante;
+// o texto é truncado na capacidade e sempre termina em '\0'.
+// Não depende do Pico SDK.
+
+typedef struct {
+    char *buf;
+    uint8_t len;  // Caracteres escritos (sem o '\0')
+    uint8_t cap;  // Tamanho de buf, incluindo o '\0'
+} text_line_t;
+
+void text_init(text_line_t *t, char *buf, uint8_t cap);
+void text_char(text_line_t *t, char c);
+void text_str(text_line_t *t, const char *s);
+void text_uint(text_line_t *t, uint32_t value, uint8_t width);
+void text_int(text_line_t *t, int32_t value, uint8_t width);
+void text_pad(text_line_t *t, uint8_t width);
+
+#endif // TEXT_FORMAT_H
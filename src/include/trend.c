@@ -0,0 +1,66 @@
+#include "trend.h"
+
+/**
+ * @brief Inicializa o estimador com uma janela de `window` amostras.
+ */
+void trend_init(trend_t *t, uint16_t window) {
+    if (window < 2) window = 2;
+    if (window > TREND_MAX_WINDOW) window = TREND_MAX_WINDOW;
+
+    t->window = window;
+    t->head = 0;
+    t->count = 0;
+    t->sum_y = 0;
+    t->sum_iy = 0;
+}
+
+/**
+ * @brief Acrescenta uma amostra à janela em tempo constante.
+ *        Quando a janela está cheia, a amostra mais antiga sai e os índices das
+ *        demais diminuem em 1, o que equivale a subtrair Σy (sem a que saiu) de Σi·y.
+ */
+void trend_push(trend_t *t, int16_t y) {
+    if (t->count < t->window) {
+        t->sum_iy += (int64_t)t->count * y;
+        t->sum_y += y;
+        t->samples[(t->head + t->count) % t->window] = y;
+        t->count++;
+        return;
+    }
+
+    int16_t oldest = t->samples[t->head];
+    t->sum_iy -= (int64_t)(t->sum_y - oldest);
+    t->sum_y -= oldest;
+
+    t->sum_iy += (int64_t)(t->window - 1) * y;
+    t->sum_y += y;
+    t->samples[t->head] = y;
+    t->head = (uint16_t)((t->head + 1) % t->window);
+}
+
+bool trend_is_full(const trend_t *t) {
+    return t->count == t->window;
+}
+
+/**
+ * @brief Inclinação da reta de mínimos quadrados, em unidades de y por minuto.
+ *
+ * @param t Estimador.
+ * @param sample_rate_hz Taxa com que as amostras são entregues a trend_push().
+ * @return Inclinação (positiva = subindo) ou 0 se houver menos de duas amostras.
+ */
+int32_t trend_slope_per_minute(const trend_t *t, uint32_t sample_rate_hz) {
+    int64_t n = t->count;
+    if (n < 2) {
+        return 0;
+    }
+
+    // Σi e Σi² para i = 0..n-1 dependem só de n
+    int64_t sum_i = n * (n - 1) / 2;
+    int64_t sum_ii = (n - 1) * n * (2 * n - 1) / 6;
+
+    int64_t numerator = n * t->sum_iy - sum_i * (int64_t)t->sum_y;
+    int64_t denominator = n * sum_ii - sum_i * sum_i;
+
+    return (int32_t)((numerator * (int64_t)sample_rate_hz * 60) / denominator);
+}
@@ -0,0 +1,28 @@
+#ifndef TREND_H
+#define TREND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Estimador de tendência por mínimos quadrados sobre uma janela deslizante.
+// Mantém somas corridas (Σy e Σi·y), de modo que cada nova amostra custa O(1),
+// e usa apenas memória pré-alocada dentro da própria estrutura.
+// Não depende do Pico SDK: pode ser alimentado no host com séries gravadas.
+
+#define TREND_MAX_WINDOW 128
+
+typedef struct {
+    int16_t samples[TREND_MAX_WINDOW]; // Janela circular de amostras
+    uint16_t window;                   // Tamanho da janela (<= TREND_MAX_WINDOW)
+    uint16_t head;                     // Posição da amostra mais antiga quando a janela está cheia
+    uint16_t count;                    // Amostras presentes na janela
+    int32_t sum_y;                     // Σ y
+    int64_t sum_iy;                    // Σ i·y, com i = 0 para a amostra mais antiga
+} trend_t;
+
+void trend_init(trend_t *t, uint16_t window);
+void trend_push(trend_t *t, int16_t y);
+bool trend_is_full(const trend_t *t);
+int32_t trend_slope_per_minute(const trend_t *t, uint32_t sample_rate_hz);
+
+#endif // TREND_H
@@ -0,0 +1,135 @@
+#include "ws2812_dma.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
+
+// --- Internal Definitions ---
+// Saídas registradas, percorridas pelo handler compartilhado do DMA_IRQ_1
+static ws2812_dma_t *ws_outputs[WS2812_DMA_MAX_OUTPUTS];
+static uint8_t ws_output_count = 0;
+// Pool de alarmes próprio, criado com a primeira saída: a IRQ do alarme de hardware
+// fica no núcleo que chamou ws2812_dma_init(), e não no do pool padrão (núcleo 0)
+static alarm_pool_t *ws_alarm_pool = NULL;
+
+// Encerra o envio atual e avisa o dono
+static void ws2812_dma_finish(ws2812_dma_t *ws) {
+    ws->in_flight = false;
+    if (ws->callback != NULL) {
+        ws->callback(ws->callback_ctx);
+    }
+}
+
+/**
+ * @brief Callback do alarme: a última palavra já saiu da PIO e o tempo de reset
+ *        passou, então a fita travou o quadro.
+ */
+static int64_t ws2812_dma_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    ws2812_dma_t *ws = (ws2812_dma_t *)user_data;
+    if (ws->in_flight) {
+        ws2812_dma_finish(ws);
+    }
+    return 0; // Não repete
+}
+
+/**
+ * @brief Handler compartilhado do DMA_IRQ_1. Para cada saída cujo DMA terminou de
+ *        escrever na FIFO, agenda o alarme para quando as palavras restantes (FIFO
+ *        + a que está no registrador de deslocamento) terminarem de sair, somado ao reset.
+ */
+static void ws2812_dma_irq_handler(void) {
+    for (uint8_t i = 0; i < ws_output_count; ++i) {
+        ws2812_dma_t *ws = ws_outputs[i];
+        if (!dma_channel_get_irq1_status((uint)ws->dma_chan)) {
+            continue;
+        }
+        dma_channel_acknowledge_irq1((uint)ws->dma_chan);
+
+        uint32_t pending_words = pio_sm_get_tx_fifo_level(ws->pio, ws->sm) + 1;
+        uint32_t latch_us = pending_words * WS2812_WORD_US + ws->reset_us;
+        // fire_if_past: se o instante já passou, o callback roda aqui mesmo;
+        // sem alarme livre no pool, termina já (a próxima escrita espera o DMA de qualquer forma)
+        if (alarm_pool_add_alarm_in_us(ws_alarm_pool, latch_us, ws2812_dma_alarm_callback, ws, true) < 0) {
+            ws2812_dma_finish(ws);
+        }
+    }
+}
+
+// --- Public API Functions ---
+
+/**
+ * @brief Reserva um canal DMA para a saída. Na primeira saída, instala o handler
+ *        do DMA_IRQ_1 e cria o pool de alarmes (um alarme de hardware livre), ambos
+ *        com a IRQ no núcleo atual. A máquina de estados já deve estar rodando o
+ *        programa WS2812 com autopull de 24 bits.
+ *
+ * @param ws Estado da saída (deve permanecer válido, normalmente estático).
+ * @param pio Instância da PIO.
+ * @param sm Máquina de estados que serializa os pixels.
+ * @param reset_us Tempo mínimo de linha baixa após o último bit (trava das cores).
+ */
+bool ws2812_dma_init(ws2812_dma_t *ws, PIO pio, uint sm, uint32_t reset_us) {
+    ws->dma_chan = -1;
+    ws->in_flight = false;
+    if (ws_output_count >= WS2812_DMA_MAX_OUTPUTS) {
+        return false;
+    }
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) {
+        return false;
+    }
+
+    ws->pio = pio;
+    ws->sm = sm;
+    ws->dma_chan = chan;
+    ws->reset_us = reset_us;
+    ws->callback = NULL;
+    ws->callback_ctx = NULL;
+
+    dma_channel_config cfg = dma_channel_get_default_config((uint)chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(pio, sm, true));
+    dma_channel_configure((uint)chan, &cfg, &pio->txf[sm], NULL, 0, false);
+
+    ws_outputs[ws_output_count++] = ws;
+    dma_channel_set_irq1_enabled((uint)chan, true);
+    if (ws_output_count == 1) {
+        ws_alarm_pool = alarm_pool_create_with_unused_hardware_alarm(WS2812_DMA_MAX_OUTPUTS);
+        irq_add_shared_handler(DMA_IRQ_1, ws2812_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+    return true;
+}
+
+/**
+ * @brief Inicia o envio de `count` pixels. Retorna imediatamente; o buffer
+ *        `pixels` deve permanecer válido e inalterado até o callback.
+ *
+ * @param ws Saída inicializada por ws2812_dma_init().
+ * @param pixels Palavras GRB já alinhadas em bits 31-8.
+ * @param count Número de LEDs.
+ * @param callback Chamado em contexto de interrupção após o tempo de reset.
+ * @param ctx Argumento repassado ao callback.
+ * @return false se já houver um envio em andamento nesta saída ou `count` for zero.
+ */
+bool ws2812_dma_write(ws2812_dma_t *ws, const uint32_t *pixels, size_t count, ws2812_dma_callback_t callback, void *ctx) {
+    if (ws->dma_chan < 0 || ws->in_flight || count == 0) {
+        return false;
+    }
+
+    ws->callback = callback;
+    ws->callback_ctx = ctx;
+    ws->in_flight = true;
+
+    dma_channel_transfer_from_buffer_now((uint)ws->dma_chan, pixels, (uint32_t)count);
+    return true;
+}
+
+/**
+ * @brief Indica se há um envio em andamento na saída (incluindo o tempo de reset).
+ */
+bool ws2812_dma_busy(const ws2812_dma_t *ws) {
+    return ws->in_flight;
+}
@@ -0,0 +1,44 @@
+#ifndef WS2812_DMA_H
+#define WS2812_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/pio.h"
+
+// Envio não bloqueante de pixels WS2812: um canal DMA alimenta a FIFO de TX da
+// máquina de estados da PIO, no ritmo do DREQ, com uma palavra GRB (bits 31-8)
+// por LED. Quando o DMA entrega a última palavra, ainda restam na FIFO as palavras
+// que a PIO não serializou; um alarme (pool de alarmes próprio, sobre um alarme de
+// hardware livre) é agendado para o instante em que elas terminam mais o tempo de reset
+// (linha baixa que trava as cores na fita). O fim é sinalizado por callback no
+// alarme (em contexto de interrupção), então o núcleo fica livre durante todo o
+// envio.
+//
+// Cada saída (máquina de estados) tem seu próprio ws2812_dma_t e canal DMA, e as
+// saídas transmitem em paralelo; cada uma tem um envio em andamento por vez.
+// A interface não depende do FreeRTOS, no mesmo molde de i2c_dma.h.
+
+#define WS2812_DMA_MAX_OUTPUTS 4 // Uma por máquina de estados de uma PIO
+
+#define WS2812_BIT_HZ      800000 // Taxa de bits do WS2812
+#define WS2812_BIT_US_X100 125    // Um bit a 800 kHz: 1,25 us
+#define WS2812_WORD_US     ((24 * WS2812_BIT_US_X100 + 99) / 100) // 24 bits por LED: 30 us
+
+typedef void (*ws2812_dma_callback_t)(void *ctx);
+
+typedef struct {
+    PIO pio;
+    uint sm;
+    int dma_chan;
+    uint32_t reset_us;
+    volatile bool in_flight;
+    ws2812_dma_callback_t callback;
+    void *callback_ctx;
+} ws2812_dma_t;
+
+bool ws2812_dma_init(ws2812_dma_t *ws, PIO pio, uint sm, uint32_t reset_us);
+bool ws2812_dma_write(ws2812_dma_t *ws, const uint32_t *pixels, size_t count, ws2812_dma_callback_t callback, void *ctx);
+bool ws2812_dma_busy(const ws2812_dma_t *ws);
+
+#endif // WS2812_DMA_H
@@ -1,9 +1,20 @@
 #include "config.h"
 #include "display.h"         // Para display_init e display_flood_startup_screen
 #include "led_matrix.h"      // Para led_matrix_init, led_matrix_display_alert, led_matrix_display_normal_status
+#include "adc_capture.h"     // Para adc_capture_init, adc_capture_wait_block
+#include "sample_ring.h"     // Para sample_ring_channel_mean
+#include "sensor_convert.h"  // Para sensor_convert_permille, sensor_permille_to_percent
+#include "trend.h"           // Para trend_push, trend_slope_per_minute
+#include "alert_rules.h"     // Para alert_rules_evaluate
+#include "forecast.h"        // Para forecast_update, forecast_seconds_to
+#include "state_bus.h"       // Para state_bus_publish, state_bus_wait, state_bus_read
+#include "sensor_history.h"  // Para sensor_history_push, sensor_history_summary
+#include "sparkline.h"       // Para sparkline_init, sparkline_push
 #include "pico/stdlib.h"     // Para stdio_init_all, gpio_init, etc.
+#include "hardware/clocks.h" // Para clock_get_hz
 #include "FreeRTOS.h"        // Para FreeRTOS
 #include "task.h"            // Para xTaskCreate, vTaskStartScheduler, vTaskDelay
+#include "timers.h"          // Para xTimerCreate, xTimerStart, xTimerStop
 #include "queue.h"           // Para QueueHandle_t, xQueueCreate, xQueueSend, xQueueReceive
 #include <stdio.h>           // Para printf
 #include <string.h>          // Para memset, strcpy, sprintf
@@ -13,11 +24,29 @@ ssd1306_t ssd;
 
 QueueHandle_t xSensorDataQueue;
 
-// Filas de Alerta Individuais para Fan-Out
-QueueHandle_t xDisplayAlertQueue;
-QueueHandle_t xRgbLedAlertQueue;
-QueueHandle_t xLedMatrixAlertQueue;
-QueueHandle_t xBuzzerAlertQueue;
+// Incrementado pelo traceTASK_SWITCHED_IN, um contador por núcleo (ver FreeRTOSConfig.h)
+volatile uint32_t ulContextSwitchCount[configNUM_CORES];
+
+// Inscrições no barramento de estado (substituem as filas individuais de fan-out)
+state_bus_sub_t xDisplayAlertSub;
+state_bus_sub_t xRgbLedAlertSub;
+state_bus_sub_t xLedMatrixAlertSub;
+state_bus_sub_t xBuzzerAlertSub;
+
+// Modo noturno da matriz, alternado pelo botão A
+static volatile bool matrix_night_mode = false;
+
+// Passos da animação da matriz: só roda enquanto a cena exibida é animada
+static TimerHandle_t matrix_anim_timer;
+
+// Agenda de quadros do display (escrita só pela tarefa do display)
+static display_scheduler_t display_sched;
+
+// Históricos de água e chuva (1 min, 10 min, 1 h) com pegada fixa
+static sensor_history_t water_history;
+static sensor_history_t rain_history;
+_Static_assert(sizeof(water_history) + sizeof(rain_history) <= SENSOR_HISTORY_RAM_BUDGET,
+               "Históricos dos sensores excedem SENSOR_HISTORY_RAM_BUDGET");
 
 // --- Task Forward Declarations ---
 void vJoystickReadTask(void *pvParameters);
@@ -26,6 +55,55 @@ void vRgbLedAlertTask(void *pvParameters);
 void vLedMatrixAlertTask(void *pvParameters);
 void vBuzzerAlertTask(void *pvParameters);
 void vDisplayInfoTask(void *pvParameters);
+static void log_history(const char *name, const sensor_history_t *history);
+
+// Soma dos contadores de troca de contexto dos núcleos
+static uint32_t context_switch_total(void) {
+    uint32_t total = 0;
+    for (int core = 0; core < configNUM_CORES; ++core) {
+        total += ulContextSwitchCount[core];
+    }
+    return total;
+}
+
+// Chamado pelo FreeRTOS na troca de contexto quando a pilha de uma tarefa estourou
+// (configCHECK_FOR_STACK_OVERFLOW): para o sistema em vez de seguir com memória corrompida
+void vApplicationStackOverflowHook(TaskHandle_t task, char *task_name) {
+    (void)task;
+    panic("Estouro de pilha na tarefa %s\n", task_name);
+}
+
+// Filtro de despacho da matriz (roda no produtor): a água é desenhada em linhas,
+// então só uma troca de linha é visível; a chuva não é desenhada
+static bool matrix_water_rows_changed(const AlertStatus_t *last, const AlertStatus_t *status) {
+    return led_matrix_water_rows(status->water_level_percent) != led_matrix_water_rows(last->water_level_percent);
+}
+
+// Timer de animação (tarefa do timer): acorda a tarefa da matriz para o próximo passo
+static void matrix_anim_timer_callback(TimerHandle_t timer) {
+    (void)timer;
+    state_bus_wake(xLedMatrixAlertSub);
+}
+
+/**
+ * @brief IRQ do botão A: alterna o brilho da matriz entre normal e noturno e acorda
+ *        a tarefa da matriz para redesenhar o estado atual com o novo brilho.
+ */
+static void button_irq_callback(uint gpio, uint32_t events) {
+    static uint32_t last_press_us = 0;
+    uint32_t now_us = time_us_32();
+    if (gpio != BUTTON_A_PIN || now_us - last_press_us < BUTTON_DEBOUNCE_MS * 1000u) {
+        return;
+    }
+    last_press_us = now_us;
+
+    matrix_night_mode = !matrix_night_mode;
+    led_matrix_set_brightness(matrix_night_mode ? MATRIX_BRIGHTNESS_NIGHT : MATRIX_BRIGHTNESS);
+
+    BaseType_t higher_priority_woken = pdFALSE;
+    state_bus_wake_from_isr(xLedMatrixAlertSub, &higher_priority_woken);
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
 
 // --- Inicialização dos perifericos ---
 void init_system_flood_alert() {
@@ -33,8 +111,8 @@ void init_system_flood_alert() {
     sleep_ms(1000); // Tempo para o terminal serial conectar
     printf("Sistema de alerta de inundação!\n");
     joystick_init();
+    adc_capture_init();
     buzzer_init(); 
-    led_matrix_init();
     display_init(&ssd);
 
     gpio_init(LED_RED_PIN); gpio_set_dir(LED_RED_PIN, GPIO_OUT); gpio_put(LED_RED_PIN, 0);
@@ -47,27 +125,81 @@ void init_system_flood_alert() {
 int main() {
     init_system_flood_alert();
     display_startup_screen(&ssd);
+    display_scheduler_init(&display_sched, DISPLAY_MAX_FPS);
 
-    xSensorDataQueue = xQueueCreate(5, sizeof(SensorData_t));
-
-    // Criação as filas de alerta individuais
-    xDisplayAlertQueue   = xQueueCreate(3, sizeof(AlertStatus_t));
-    xRgbLedAlertQueue    = xQueueCreate(3, sizeof(AlertStatus_t));
-    xLedMatrixAlertQueue = xQueueCreate(3, sizeof(AlertStatus_t));
-    xBuzzerAlertQueue    = xQueueCreate(3, sizeof(AlertStatus_t));
+    xSensorDataQueue = xQueueCreate(5, sizeof(SensorBlock_t));
 
-    if (xSensorDataQueue == NULL || xDisplayAlertQueue == NULL ||
-        xRgbLedAlertQueue == NULL || xLedMatrixAlertQueue == NULL || xBuzzerAlertQueue == NULL) {
+    if (xSensorDataQueue == NULL) {
         while(1);
     }
 
+    // Custo de heap de uma fila de alerta com a geometria do fan-out antigo (3 x AlertStatus_t),
+    // medido criando e destruindo uma fila de teste; o barramento não usa heap
+    size_t heap_before = xPortGetFreeHeapSize();
+    QueueHandle_t probe_queue = xQueueCreate(3, sizeof(AlertStatus_t));
+    size_t queue_heap_bytes = heap_before - xPortGetFreeHeapSize();
+    if (probe_queue != NULL) {
+        vQueueDelete(probe_queue);
+    }
+
+    AlertStatus_t initial_status;
+    memset(&initial_status, 0, sizeof(AlertStatus_t));
+    initial_status.level = ALERT_NONE;
+    initial_status.severity = ALERT_SEVERITY_NONE;
+    initial_status.seconds_to_threshold = -1;
+    initial_status.sample_timestamp_us = time_us_32();
+    state_bus_init(&initial_status);
+
     printf("Tarefas Criadas\n");
-    xTaskCreate(vJoystickReadTask, "JoystickRead", STACK_SIZE_DEFAULT, NULL, PRIORITY_JOYSTICK_READ, NULL);
-    xTaskCreate(vDataProcessingTask, "DataProcess", STACK_SIZE_DEFAULT, NULL, PRIORITY_DATA_PROCESSING, NULL);
-    xTaskCreate(vRgbLedAlertTask, "RgbLedAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_RGB_LED_ALERT, NULL);
-    xTaskCreate(vLedMatrixAlertTask, "MatrixAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_MATRIX_ALERT, NULL);
-    xTaskCreate(vBuzzerAlertTask, "BuzzerAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_BUZZER_ALERT, NULL);
-    xTaskCreate(vDisplayInfoTask, "DisplayInfo", STACK_SIZE_DISPLAY, &ssd, PRIORITY_DISPLAY_INFO, NULL);
+    TaskHandle_t joystick_task, processing_task, rgb_task, matrix_task, buzzer_task, display_task;
+    xTaskCreate(vJoystickReadTask, "JoystickRead", STACK_SIZE_DEFAULT, NULL, PRIORITY_JOYSTICK_READ, &joystick_task);
+    xTaskCreate(vDataProcessingTask, "DataProcess", STACK_SIZE_DEFAULT, NULL, PRIORITY_DATA_PROCESSING, &processing_task);
+    xTaskCreate(vRgbLedAlertTask, "RgbLedAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_RGB_LED_ALERT, &rgb_task);
+    xTaskCreate(vLedMatrixAlertTask, "MatrixAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_MATRIX_ALERT, &matrix_task);
+    xTaskCreate(vBuzzerAlertTask, "BuzzerAlert", STACK_SIZE_DEFAULT, NULL, PRIORITY_BUZZER_ALERT, &buzzer_task);
+    xTaskCreate(vDisplayInfoTask, "DisplayInfo", STACK_SIZE_DISPLAY, &ssd, PRIORITY_DISPLAY_INFO, &display_task);
+
+#if ( configNUM_CORES > 1 )
+    // Aquisição e processamento no núcleo da IRQ do ADC; saídas bloqueantes no outro núcleo
+    vTaskCoreAffinitySet(joystick_task, CORE_MASK_ACQUISITION);
+    vTaskCoreAffinitySet(processing_task, CORE_MASK_ACQUISITION);
+    vTaskCoreAffinitySet(rgb_task, CORE_MASK_OUTPUT);
+    vTaskCoreAffinitySet(matrix_task, CORE_MASK_OUTPUT);
+    vTaskCoreAffinitySet(buzzer_task, CORE_MASK_OUTPUT);
+    vTaskCoreAffinitySet(display_task, CORE_MASK_OUTPUT);
+#endif
+    printf("FreeRTOS com %d nucleo(s)\n", configNUM_CORES);
+
+    // Os consumidores se inscrevem antes do escalonador iniciar: cada um custa só uma entrada na tabela.
+    // A zona morta de cada um reflete os campos que ele realmente usa
+    const state_bus_deadband_t level_only = {
+        STATE_BUS_IGNORE, STATE_BUS_IGNORE, STATE_BUS_IGNORE, STATE_BUS_IGNORE, STATE_BUS_IGNORE };
+    const state_bus_deadband_t display_deadband = {
+        DISPATCH_DISPLAY_PERCENT_DEADBAND, DISPATCH_DISPLAY_PERCENT_DEADBAND, STATE_BUS_IGNORE,
+        DISPATCH_DISPLAY_ETA_DEADBAND_S, DISPATCH_DISPLAY_PERCENT_DEADBAND };
+    xRgbLedAlertSub    = state_bus_subscribe(rgb_task, &level_only);
+    xLedMatrixAlertSub = state_bus_subscribe(matrix_task, &level_only);
+    state_bus_set_filter(xLedMatrixAlertSub, matrix_water_rows_changed); // A água só importa por linha
+    xBuzzerAlertSub    = state_bus_subscribe(buzzer_task, &level_only);
+    xDisplayAlertSub   = state_bus_subscribe(display_task, &display_deadband);
+    if (xRgbLedAlertSub < 0 || xLedMatrixAlertSub < 0 || xBuzzerAlertSub < 0 || xDisplayAlertSub < 0) {
+        while(1);
+    }
+
+    matrix_anim_timer = xTimerCreate("MatrixAnim", pdMS_TO_TICKS(1000 / MATRIX_ANIM_FPS), pdTRUE, NULL,
+                                     matrix_anim_timer_callback);
+    if (matrix_anim_timer == NULL) {
+        while(1);
+    }
+
+    // Botão A (ativo em nível baixo) alterna o modo noturno da matriz
+    gpio_init(BUTTON_A_PIN);
+    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
+    gpio_pull_up(BUTTON_A_PIN);
+    gpio_set_irq_enabled_with_callback(BUTTON_A_PIN, GPIO_IRQ_EDGE_FALL, true, button_irq_callback);
+
+    printf("StateBus: fan-out por filas usaria %u B de heap (4 x %u B); barramento: 0 B de heap\n",
+        (unsigned)(4 * queue_heap_bytes), (unsigned)queue_heap_bytes);
 
     vTaskStartScheduler();
 
@@ -79,70 +211,199 @@ int main() {
 
 /**
  * @brief Task responsável pelo processamento dos dados dos sensores (simulados com o joysitck).
- * Esta tarefa aguarda indefinidamente por novos dados de sensores simulados
+ * Esta tarefa aguarda indefinidamente por novos lotes de leituras simuladas
  * (nível de água e volume de chuva) provenientes da fila `xSensorDataQueue`.
- * Ao receber os dados, ela calcula o status de alerta (se algum limiar foi
+ * Cada lote (`SensorBlock_t`) traz SENSOR_BLOCK_LEN leituras por canal, que são
+ * processadas de uma só vez a cada despertar. Ao receber os dados, ela calcula o status de alerta (se algum limiar foi
  * atingido) e determina o nível de alerta (nenhum, água alta, chuva alta ou ambos).
  **/
 void vDataProcessingTask(void *pvParameters) {
     printf("Task principal inicializada.\n");
-    SensorData_t received_data;
+    SensorBlock_t received_block;
     AlertStatus_t alert_status;
+    static trend_t water_trend; // Janela pré-alocada fora da stack da tarefa
+    forecast_t water_forecast;
+    TickType_t stats_start = xTaskGetTickCount();
+    uint32_t switches_start = context_switch_total();
+    uint32_t blocks_received = 0;
+    led_matrix_anim_stats_t matrix_start; // A matriz roda no outro núcleo: contadores só são lidos
+    led_matrix_get_anim_stats(&matrix_start);
+    state_bus_stats_t bus_start; // Idem para os inscritos do barramento
+    state_bus_get_stats(&bus_start);
+    uint32_t sub_delivered_start[STATE_BUS_MAX_SUBSCRIBERS] = { 0 };
+    uint32_t sub_suppressed_start[STATE_BUS_MAX_SUBSCRIBERS] = { 0 };
 
     alert_status.is_alert_active = false;
     alert_status.level = ALERT_NONE;
+    alert_status.severity = ALERT_SEVERITY_NONE;
     alert_status.water_level_percent = 0;
     alert_status.rain_volume_percent = 0;
+    alert_status.water_rise_per_min = 0;
+    alert_status.seconds_to_threshold = FORECAST_NO_ESTIMATE;
+    alert_status.water_max_1h_percent = 0;
+    alert_status.sample_timestamp_us = 0;
+    trend_init(&water_trend, TREND_WINDOW_SAMPLES);
+    sensor_history_init(&water_history, SENSOR_OUTPUT_RATE_HZ);
+    sensor_history_init(&rain_history, SENSOR_OUTPUT_RATE_HZ);
+    printf("Historico: %u B de RAM (orcamento %u B)\n",
+        (unsigned)(sizeof(water_history) + sizeof(rain_history)), (unsigned)SENSOR_HISTORY_RAM_BUDGET);
+    forecast_init(&water_forecast, FORECAST_ALPHA_SHIFT, FORECAST_BETA_SHIFT);
 
     while (true) {
-        if (xQueueReceive(xSensorDataQueue, &received_data, portMAX_DELAY)) {
-            alert_status.water_level_percent = received_data.water_level_percent;
-            alert_status.rain_volume_percent = received_data.rain_volume_percent;
-
-            bool water_alert = (received_data.water_level_percent >= WATER_LEVEL_ALERT_THRESHOLD);
-            bool rain_alert = (received_data.rain_volume_percent >= RAIN_VOLUME_ALERT_THRESHOLD);
-
-            if (water_alert && rain_alert) {
-                alert_status.level = ALERT_BOTH_HIGH;
-                alert_status.is_alert_active = true;
-            } else if (water_alert) {
-                alert_status.level = ALERT_WATER_HIGH;
-                alert_status.is_alert_active = true;
-            } else if (rain_alert) {
-                alert_status.level = ALERT_RAIN_HIGH;
-                alert_status.is_alert_active = true;
-            } else {
-                alert_status.level = ALERT_NONE;
-                alert_status.is_alert_active = false;
-            }
-
-            if (xQueueSend(xDisplayAlertQueue, &alert_status, 0) != pdPASS) {
-                printf("DataProcessing: Failed to send to DisplayAlertQueue\n");
+        if (xQueueReceive(xSensorDataQueue, &received_block, portMAX_DELAY)) {
+            blocks_received++;
+
+            // Processa o lote inteiro de uma vez: cada leitura alimenta a tendência (O(1))
+            // e o status publicado reflete a leitura mais recente
+            for (uint8_t i = 0; i < received_block.count; ++i) {
+                trend_push(&water_trend, (int16_t)received_block.water_level_permille[i]);
+                forecast_update(&water_forecast, received_block.water_level_permille[i]);
+                sensor_history_push(&water_history, received_block.water_level_permille[i]);
+                sensor_history_push(&rain_history, received_block.rain_volume_permille[i]);
             }
-            if (xQueueSend(xRgbLedAlertQueue, &alert_status, 0) != pdPASS) {
-                printf("DataProcessing: Failed to send to RgbLedAlertQueue\n");
+            uint16_t water_permille = received_block.water_level_permille[received_block.count - 1];
+            uint16_t rain_permille = received_block.rain_volume_permille[received_block.count - 1];
+            alert_status.sample_timestamp_us = received_block.timestamp_us[received_block.count - 1];
+            int32_t rise = trend_slope_per_minute(&water_trend, SENSOR_OUTPUT_RATE_HZ);
+
+            alert_status.water_level_percent = sensor_permille_to_percent(water_permille);
+            alert_status.rain_volume_percent = sensor_permille_to_percent(rain_permille);
+            alert_status.water_rise_per_min = (int16_t)(rise > INT16_MAX ? INT16_MAX : (rise < INT16_MIN ? INT16_MIN : rise));
+            alert_status.seconds_to_threshold = (int16_t)forecast_seconds_to(&water_forecast,
+                WATER_LEVEL_ALERT_THRESHOLD * 10, SENSOR_OUTPUT_RATE_HZ, FORECAST_HORIZON_S);
+            history_summary_t last_hour;
+            if (sensor_history_summary(&water_history, HISTORY_SPAN_1H, &last_hour)) {
+                alert_status.water_max_1h_percent = sensor_permille_to_percent(last_hour.max);
             }
-            if (xQueueSend(xLedMatrixAlertQueue, &alert_status, 0) != pdPASS) {
-                printf("DataProcessing: Failed to send to LedMatrixAlertQueue\n");
-            }
-            if (xQueueSend(xBuzzerAlertQueue, &alert_status, 0) != pdPASS) {
-                printf("DataProcessing: Failed to send to BuzzerAlertQueue\n");
+
+            // Classificação pelo motor de regras: limiares por sensor + uma consulta à tabela.
+            // Só avalia a subida com a janela cheia, para não reagir a poucas amostras
+            int32_t rule_inputs[ALERT_SENSOR_COUNT];
+            rule_inputs[ALERT_SENSOR_WATER] = water_permille;
+            rule_inputs[ALERT_SENSOR_RAIN] = rain_permille;
+            rule_inputs[ALERT_SENSOR_RISE] = trend_is_full(&water_trend) ? rise : 0;
+
+            AlertRuleResult_t rule = alert_rules_evaluate(rule_inputs);
+            alert_status.level = (AlertLevel_t)rule.level;
+            alert_status.severity = (AlertSeverity_t)rule.severity;
+            alert_status.is_alert_active = (alert_status.level != ALERT_NONE);
+
+            // Uma única cópia no snapshot compartilhado; os inscritos são apenas notificados
+            state_bus_publish(&alert_status);
+        }
+
+        // Benchmark do lote: trocas de contexto por segundo para o SENSOR_BLOCK_LEN atual
+        TickType_t elapsed = xTaskGetTickCount() - stats_start;
+        if (elapsed >= pdMS_TO_TICKS(SENSOR_STATS_INTERVAL_MS)) {
+            uint32_t switches = context_switch_total() - switches_start;
+            printf("Lote=%d: %lu trocas de contexto/s, %lu lotes/s (%d leituras/s)\n",
+                SENSOR_BLOCK_LEN,
+                (unsigned long)(switches * configTICK_RATE_HZ / elapsed),
+                (unsigned long)(blocks_received * configTICK_RATE_HZ / elapsed),
+                SENSOR_OUTPUT_RATE_HZ);
+            log_history("Agua", &water_history);
+            log_history("Chuva", &rain_history);
+
+            // Despacho por mudança: entregas x supressões por consumidor
+            static const char *const sub_names[] = { "RGB", "Matriz", "Buzzer", "Display" };
+            const state_bus_sub_t subs[] = { xRgbLedAlertSub, xLedMatrixAlertSub, xBuzzerAlertSub, xDisplayAlertSub };
+            for (uint8_t i = 0; i < sizeof(subs) / sizeof(subs[0]); ++i) {
+                uint32_t delivered, suppressed;
+                state_bus_get_sub_counts(subs[i], &delivered, &suppressed);
+                printf("  %-7s entregues %lu, suprimidos %lu\n", sub_names[i],
+                    (unsigned long)(delivered - sub_delivered_start[i]),
+                    (unsigned long)(suppressed - sub_suppressed_start[i]));
+                sub_delivered_start[i] = delivered;
+                sub_suppressed_start[i] = suppressed;
             }
+
+            // Contadores acumulados desde o boot; em regime estável só "sem mudanca" cresce
+            uint32_t strip_hits, strip_misses;
+            ssd1306_strip_cache_stats(&strip_hits, &strip_misses);
+            printf("Display: %lu quadros desenhados, %lu acordadas sem mudanca, %lu esperas de FPS agrupadas, %lu bytes I2C, cache de textos %lu/%lu acertos\n",
+                (unsigned long)display_sched.rendered,
+                (unsigned long)display_sched.skipped,
+                (unsigned long)display_sched.coalesced,
+                (unsigned long)ssd.bytes_sent_total,
+                (unsigned long)strip_hits,
+                (unsigned long)(strip_hits + strip_misses));
+            uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+            printf("Display: quadro %lu us (~%lu ciclos, max %lu us), pilha livre %lu de %u palavras, envios atrasados %lu\n",
+                (unsigned long)display_sched.frame_us_last,
+                (unsigned long)(display_sched.frame_us_last * cycles_per_us),
+                (unsigned long)display_sched.frame_us_max,
+                (unsigned long)display_sched.stack_free_words,
+                (unsigned)STACK_SIZE_DISPLAY,
+                (unsigned long)display_sched.tx_timeouts);
+            led_matrix_anim_stats_t matrix_stats;
+            led_matrix_get_anim_stats(&matrix_stats);
+            uint32_t matrix_steps = matrix_stats.steps - matrix_start.steps;
+            printf("Matriz: %lu passos, %lu quadros enviados, %lu sem mudanca, CPU media %lu us (max %lu us desde o boot), intervalo max %lu us (nominal %u us), %lu descartados por envio DMA pendente\n",
+                (unsigned long)matrix_steps,
+                (unsigned long)(matrix_stats.pushed - matrix_start.pushed),
+                (unsigned long)(matrix_stats.skipped - matrix_start.skipped),
+                (unsigned long)(matrix_steps ? (matrix_stats.update_us_total - matrix_start.update_us_total) / matrix_steps : 0),
+                (unsigned long)matrix_stats.update_us_max,
+                (unsigned long)matrix_stats.interval_us_max,
+                (unsigned)(1000000 / MATRIX_ANIM_FPS),
+                (unsigned long)led_matrix_render_timeouts());
+            matrix_start = matrix_stats;
+
+            state_bus_stats_t bus_stats;
+            state_bus_get_stats(&bus_stats);
+            uint32_t publishes = bus_stats.publishes - bus_start.publishes;
+            uint32_t applied = bus_stats.applied - bus_start.applied;
+            printf("StateBus: %lu publicacoes, %lu entregas, %lu suprimidas, publish medio %lu us (max %lu us), atraso ate leitura max %lu us, releituras %lu\n",
+                (unsigned long)publishes,
+                (unsigned long)(bus_stats.delivered - bus_start.delivered),
+                (unsigned long)(bus_stats.suppressed - bus_start.suppressed),
+                (unsigned long)(publishes ? (bus_stats.publish_us_total - bus_start.publish_us_total) / publishes : 0),
+                (unsigned long)bus_stats.publish_us_max,
+                (unsigned long)bus_stats.wake_us_max,
+                (unsigned long)(bus_stats.read_retries - bus_start.read_retries));
+            printf("Latencia fim a fim (%d nucleo(s)): media %lu us, max %lu us em %lu saidas (maximos desde o boot)\n",
+                configNUM_CORES,
+                (unsigned long)(applied ? (bus_stats.e2e_us_total - bus_start.e2e_us_total) / applied : 0),
+                (unsigned long)bus_stats.e2e_us_max,
+                (unsigned long)applied);
+            bus_start = bus_stats;
+            stats_start = xTaskGetTickCount();
+            switches_start = context_switch_total();
+            blocks_received = 0;
+        }
+    }
+}
+
+/**
+ * @brief Imprime mínimo, média, máximo e percentis de cada janela do histórico (em %).
+ */
+static void log_history(const char *name, const sensor_history_t *history) {
+    static const char *const span_names[HISTORY_SPAN_COUNT] = { "1min", "10min", "1h" };
+    for (uint8_t s = 0; s < HISTORY_SPAN_COUNT; ++s) {
+        history_summary_t summary;
+        if (!sensor_history_summary(history, (history_span_t)s, &summary)) {
+            continue;
         }
+        printf("  %s %-5s (%us): min %u%% med %u%% max %u%% p50 %u%% p90 %u%%\n",
+            name, span_names[s], summary.seconds,
+            sensor_permille_to_percent(summary.min), sensor_permille_to_percent(summary.mean),
+            sensor_permille_to_percent(summary.max), sensor_permille_to_percent(summary.p50),
+            sensor_permille_to_percent(summary.p90));
     }
 }
 
 /**
  * @brief Task responsável pelo controle do LED RGB de alerta.
  *
- * Esta tarefa aguarda indefinidamente por um novo status de alerta (`AlertStatus_t`)
- * da sua fila dedicada, `xRgbLedAlertQueue`.
+ * Esta tarefa aguarda indefinidamente por uma notificação do barramento de estado
+ * e lê o `AlertStatus_t` mais recente pela inscrição `xRgbLedAlertSub`.
  **/
 void vRgbLedAlertTask(void *pvParameters) {
     AlertStatus_t current_alert;
     printf("Task RgbLedAlert started.\n");
     while (true) {
-        if (xQueueReceive(xRgbLedAlertQueue, &current_alert, portMAX_DELAY)) {
+        if (state_bus_wait(portMAX_DELAY)) {
+            state_bus_read(xRgbLedAlertSub, &current_alert);
             if (current_alert.is_alert_active) {
                 gpio_put(LED_RED_PIN, 1);
                 gpio_put(LED_GREEN_PIN, 0);
@@ -152,6 +413,7 @@ void vRgbLedAlertTask(void *pvParameters) {
                 gpio_put(LED_GREEN_PIN, 1);
                 gpio_put(LED_BLUE_PIN, 0);
             }
+            state_bus_note_applied(xRgbLedAlertSub, &current_alert);
         }
     }
 }
@@ -159,19 +421,33 @@ void vRgbLedAlertTask(void *pvParameters) {
 /**
  * @brief Task responsável por exibir informações de alerta na matriz de LEDs.
  *
- * Esta tarefa aguarda indefinidamente por um novo status de alerta (`AlertStatus_t`)
- * da sua fila dedicada, `xLedMatrixAlertQueue`.
+ * Esta tarefa aguarda indefinidamente por uma notificação do barramento de estado
+ * e lê o `AlertStatus_t` mais recente pela inscrição `xLedMatrixAlertSub`.
+ * O estado escolhe a cena (animada ou não); cada acordada avança a animação e só
+ * envia o quadro se algum pixel mudou. Enquanto a cena é animada, o timer
+ * `matrix_anim_timer` acorda a tarefa a MATRIX_ANIM_FPS pela mesma notificação.
+ * O quadro segue para a matriz por DMA; a tarefa dorme até a notificação de fim
+ * do envio (após o tempo de reset) antes de registrar a saída como aplicada.
  **/
 void vLedMatrixAlertTask(void *pvParameters) {
     AlertStatus_t current_alert_status;
     memset(&current_alert_status, 0, sizeof(AlertStatus_t));
     current_alert_status.is_alert_active = false;
     current_alert_status.level = ALERT_NONE;
+    uint32_t applied_seq = 0;
 
     printf("Task LedMatrixAlert started.\n");
+    // Inicializada aqui, e não em main(): o DMA_IRQ_1 e o pool de alarmes da fita
+    // ficam no núcleo desta tarefa (o das saídas), fora do núcleo da aquisição
+    led_matrix_init();
+    // O filtro da matriz só acorda em mudanças de estado, e o instantâneo inicial já
+    // conta como entregue: sem esta acordada a matriz ficaria apagada até a primeira
+    // mudança. Ela desenha o estado atual na primeira volta do laço
+    state_bus_wake(xLedMatrixAlertSub);
     while (true) {
 
-        if (xQueueReceive(xLedMatrixAlertQueue, &current_alert_status, portMAX_DELAY)) {
+        if (state_bus_wait(portMAX_DELAY)) {
+            uint32_t seq = state_bus_read(xLedMatrixAlertSub, &current_alert_status);
             if (current_alert_status.is_alert_active) {
                 led_matrix_display_alert(
                     current_alert_status.level,
@@ -181,6 +457,22 @@ void vLedMatrixAlertTask(void *pvParameters) {
             } else {
                 led_matrix_display_normal_status();
             }
+            if (led_matrix_update()) {
+                led_matrix_wait_rendered(pdMS_TO_TICKS(MATRIX_TX_TIMEOUT_MS));
+            }
+            // Passos do timer não trazem estado novo: não entram na latência fim a fim
+            if (seq != applied_seq) {
+                state_bus_note_applied(xLedMatrixAlertSub, &current_alert_status);
+                applied_seq = seq;
+            }
+
+            if (led_matrix_animating()) {
+                if (xTimerIsTimerActive(matrix_anim_timer) == pdFALSE) {
+                    xTimerStart(matrix_anim_timer, 0);
+                }
+            } else if (xTimerIsTimerActive(matrix_anim_timer) != pdFALSE) {
+                xTimerStop(matrix_anim_timer, 0);
+            }
         }
     }
 }
@@ -189,7 +481,7 @@ void vLedMatrixAlertTask(void *pvParameters) {
  * @brief Task responsável pelo controle do buzzer de alerta sonoro.
  *
  * Esta tarefa gerencia a ativação e o padrão sonoro do buzzer com base no
- * status de alerta recebido da sua fila dedicada, `xBuzzerAlertQueue`.
+ * status de alerta lido do barramento de estado pela inscrição `xBuzzerAlertSub`.
  **/ 
 void vBuzzerAlertTask(void *pvParameters) {
     printf("Tarefa do buzzer inicializada.\n");
@@ -202,7 +494,8 @@ void vBuzzerAlertTask(void *pvParameters) {
     while (true) {
         // Tenta receber um novo status de alerta.
         // Usar um timeout aqui permite que a lógica de "buzzer_active" funcione mesmo sem novos dados.
-        if (xQueueReceive(xBuzzerAlertQueue, &current_alert, pdMS_TO_TICKS(10))) {
+        if (state_bus_wait(pdMS_TO_TICKS(10))) {
+            state_bus_read(xBuzzerAlertSub, &current_alert);
             buzzer_active = current_alert.is_alert_active && (current_alert.level != ALERT_NONE);
             if (!buzzer_active) {
                 buzzer_play_tone(0, 0); // Desliga imediatamente se o alerta cessou
@@ -210,7 +503,7 @@ void vBuzzerAlertTask(void *pvParameters) {
         }
 
         // Lógica de tocar o buzzer baseada no estado mais recente de 'buzzer_active'
-        // e 'current_alert' (que foi atualizado pelo xQueueReceive)
+        // e 'current_alert' (que foi atualizado pelo state_bus_read)
         if (buzzer_active) {
             switch (current_alert.level) { // current_alert retém o último estado de alerta recebido
                 case ALERT_WATER_HIGH:
@@ -225,6 +518,10 @@ void vBuzzerAlertTask(void *pvParameters) {
                     buzzer_play_tone(BUZZER_ALERT_BOTH_FREQ, BUZZER_ALERT_BOTH_ON_MS);
                     vTaskDelay(pdMS_TO_TICKS(BUZZER_ALERT_BOTH_OFF_MS + BUZZER_ALERT_BOTH_ON_MS));
                     break;
+                case ALERT_RAPID_RISE:
+                    buzzer_play_tone(BUZZER_ALERT_RISE_FREQ, BUZZER_ALERT_RISE_ON_MS);
+                    vTaskDelay(pdMS_TO_TICKS(BUZZER_ALERT_RISE_OFF_MS + BUZZER_ALERT_RISE_ON_MS));
+                    break;
                 default: // ALERT_NONE ou inesperado enquanto buzzer_active é true (não deveria acontecer)
                     buzzer_play_tone(0, 0); // Desliga
                     buzzer_active = false; // Corrige estado
@@ -240,57 +537,95 @@ void vBuzzerAlertTask(void *pvParameters) {
 }
 
 /**
- * @brief Task responsável pela leitura periódica dos dados do joystick.
+ * @brief Task responsável pela leitura dos dados do joystick.
  *
  * Esta tarefa simula a leitura de sensores de nível de água e volume de chuva
- * através dos eixos X e Y de um joystick analógico.
+ * através dos eixos X e Y de um joystick analógico. O ADC converte os dois eixos
+ * continuamente em round-robin e o DMA preenche um anel duplo de blocos; a tarefa
+ * só acorda quando um bloco está cheio, passa cada canal pelo filtro de
+ * decimação e publica uma leitura a cada saída do filtro.
  **/ 
 void vJoystickReadTask(void *pvParameters) {
-    SensorData_t current_data;
+    SensorBlock_t current_block;
+    sensor_convert_t water_convert;
+    sensor_convert_t rain_convert;
+    sensor_filter_t water_filter;
+    sensor_filter_t rain_filter;
+    uint16_t water_q4[ADC_CAPTURE_BLOCK_SAMPLES];
+    uint16_t rain_q4[ADC_CAPTURE_BLOCK_SAMPLES];
+    uint16_t output_index[ADC_CAPTURE_BLOCK_SAMPLES];
+    uint32_t blocks_since_report = 0;
+    uint32_t wake_us_min = UINT32_MAX; // Atraso entre o fim do bloco (IRQ do DMA) e a tarefa processá-lo
+    uint32_t wake_us_max = 0;
+    const uint32_t cpu_mhz = clock_get_hz(clk_sys) / 1000000;
     printf("Tarefa do joystick iniciada.\n");
 
-    while (true) {
-        current_data.water_level_raw = joystick_read_x();
-        current_data.rain_volume_raw = joystick_read_y();
-
-        int32_t value_x = (int32_t)current_data.water_level_raw;
-        int32_t value_y = (int32_t)current_data.rain_volume_raw;
-
-        // Clamping para os valores definidos (importante se ADC_MIN/MAX não cobrem toda a faixa do ADC)
-        if (value_x < ADC_MIN_VALUE) value_x = ADC_MIN_VALUE;
-        if (value_x > ADC_MAX_VALUE) value_x = ADC_MAX_VALUE;
+    sensor_convert_init(&water_convert, ADC_MIN_VALUE, ADC_MAX_VALUE);
+    sensor_convert_init(&rain_convert, ADC_MIN_VALUE, ADC_MAX_VALUE); // Assumindo mesma faixa para Y, ajuste se necessário
+    sensor_filter_init(&water_filter, SENSOR_FILTER_MODE, SENSOR_FILTER_OSR_LOG2, SENSOR_FILTER_IIR_SHIFT);
+    sensor_filter_init(&rain_filter, SENSOR_FILTER_MODE, SENSOR_FILTER_OSR_LOG2, SENSOR_FILTER_IIR_SHIFT);
 
-        if (value_y < ADC_MIN_VALUE) value_y = ADC_MIN_VALUE; // Assumindo mesma faixa para Y, ajuste se necessário
-        if (value_y > ADC_MAX_VALUE) value_y = ADC_MAX_VALUE;
+    current_block.count = 0;
+    adc_capture_start(xTaskGetCurrentTaskHandle());
 
-        // Conversão para porcentagem
-        // Garante que o denominador não seja zero
-        float percent_x = 0.0f;
-        if ((ADC_MAX_VALUE - ADC_MIN_VALUE) != 0) {
-            percent_x = ((float)(value_x - ADC_MIN_VALUE) / (ADC_MAX_VALUE - ADC_MIN_VALUE)) * 100.0f;
+    while (true) {
+        const uint16_t *block = adc_capture_wait_block(portMAX_DELAY);
+        if (block == NULL) {
+            continue;
         }
 
-        float percent_y = 0.0f;
-        if ((ADC_MAX_VALUE - ADC_MIN_VALUE) != 0) { // Assumindo mesma faixa para Y
-            percent_y = ((float)(value_y - ADC_MIN_VALUE) / (ADC_MAX_VALUE - ADC_MIN_VALUE)) * 100.0f;
+        uint32_t block_end_us = adc_capture_block_timestamp_us();
+        uint32_t start_us = time_us_32();
+        uint32_t wake_us = start_us - block_end_us;
+        if (wake_us < wake_us_min) wake_us_min = wake_us;
+        if (wake_us > wake_us_max) wake_us_max = wake_us;
+        uint16_t water_count = sensor_filter_process(&water_filter, &block[ADC_CAPTURE_WATER_SLOT],
+            ADC_CAPTURE_BLOCK_SAMPLES, ADC_CAPTURE_CHANNEL_COUNT, water_q4, output_index);
+        uint32_t mid_us = time_us_32();
+        uint16_t rain_count = sensor_filter_process(&rain_filter, &block[ADC_CAPTURE_RAIN_SLOT],
+            ADC_CAPTURE_BLOCK_SAMPLES, ADC_CAPTURE_CHANNEL_COUNT, rain_q4, NULL);
+        sensor_filter_account(&water_filter, mid_us - start_us);
+        sensor_filter_account(&rain_filter, time_us_32() - mid_us);
+        adc_capture_release_block();
+
+        // Os dois canais usam a mesma decimação, então produzem o mesmo número de saídas
+        uint16_t outputs = (water_count < rain_count) ? water_count : rain_count;
+        for (uint16_t i = 0; i < outputs; ++i) {
+            uint8_t n = current_block.count;
+            // A última amostra do bloco corresponde a block_end_us; as anteriores estão espaçadas pelo período do ADC
+            current_block.timestamp_us[n] = block_end_us -
+                (uint32_t)(ADC_CAPTURE_BLOCK_SAMPLES - 1 - output_index[i]) * (1000000u / ADC_CAPTURE_SAMPLE_RATE_HZ);
+            // Conversão em ponto fixo: clamp na faixa de calibração e escala pré-calculada (sem soft-float)
+            current_block.water_level_permille[n] = sensor_convert_permille_q4(&water_convert, water_q4[i]);
+            current_block.rain_volume_permille[n] = sensor_convert_permille_q4(&rain_convert, rain_q4[i]);
+            current_block.count = ++n;
+
+            if (n == SENSOR_BLOCK_LEN) {
+                if (xQueueSend(xSensorDataQueue, &current_block, pdMS_TO_TICKS(10)) != pdPASS) {
+                    printf("leitura falhando\n");
+                }
+                current_block.count = 0;
+            }
         }
-        
-        current_data.water_level_percent = (uint8_t)percent_x;
-        current_data.rain_volume_percent = (uint8_t)percent_y;
-
-        // Limites de segurança (devem ser raramente atingidos se a calibração e o clamp acima estiverem corretos)
-        if (current_data.water_level_percent > 100) current_data.water_level_percent = 100;
-        if (percent_x < 0 && current_data.water_level_percent != 0) current_data.water_level_percent = 0; // Evita underflow de float negativo
 
-        if (current_data.rain_volume_percent > 100) current_data.rain_volume_percent = 100;
-        if (percent_y < 0 && current_data.rain_volume_percent != 0) current_data.rain_volume_percent = 0;
-
-
-        if (xQueueSend(xSensorDataQueue, &current_data, pdMS_TO_TICKS(10)) != pdPASS) {
-            printf("leitura falhando\n");
+        if (++blocks_since_report >= SENSOR_FILTER_REPORT_BLOCKS) {
+            printf("Filtro: %lu ciclos/amostra (OSR %u, +%u bits), overruns ADC: %lu\n",
+                (unsigned long)sensor_filter_cycles_per_sample(&water_filter, cpu_mhz),
+                1u << water_filter.osr_log2,
+                sensor_filter_extra_bits(&water_filter),
+                (unsigned long)adc_capture_overruns());
+            // Jitter de amostragem: variação do atraso até a tarefa atender cada bloco
+            printf("Aquisicao (%d nucleo(s)): atraso IRQ->tarefa min %lu us, max %lu us, jitter %lu us\n",
+                configNUM_CORES,
+                (unsigned long)wake_us_min,
+                (unsigned long)wake_us_max,
+                (unsigned long)(wake_us_max - wake_us_min));
+            sensor_filter_reset_stats(&water_filter);
+            sensor_filter_reset_stats(&rain_filter);
+            wake_us_min = UINT32_MAX;
+            wake_us_max = 0;
+            blocks_since_report = 0;
         }
-
-        vTaskDelay(pdMS_TO_TICKS(JOYSTICK_READ_DELAY_MS));
     }
 }
 
@@ -299,57 +634,56 @@ void vDisplayInfoTask(void *pvParameters) {
     printf("Tarefa do display inicializada.\n");
     ssd1306_t *ssd = (ssd1306_t *)pvParameters;
     AlertStatus_t current_alert_status;
+    display_model_t model;
+    sparkline_t water_graph;
 
-    // Inicialize para um estado conhecido
-    memset(&current_alert_status, 0, sizeof(AlertStatus_t));
-    current_alert_status.level = ALERT_NONE;
-    current_alert_status.is_alert_active = false;
-    current_alert_status.water_level_percent = 0;
-    current_alert_status.rain_volume_percent = 0; 
-
-    char line1[30];
-    char line2[30];
-    char line3[30];
-    char line4[30];
+    // IRQ do I2C no núcleo desta tarefa (o das saídas), fora do núcleo da aquisição
+    display_start_dma();
 
-    while (true) {
-        // Tenta receber o status de alerta da sua fila dedicada.
-        if (xQueueReceive(xDisplayAlertQueue, &current_alert_status, pdMS_TO_TICKS(DISPLAY_UPDATE_DELAY_MS / 2))) {
-            printf("DisplayTask: AlertStatus recebido. Agua: %u%%, Chuva: %u%%, Active: %d, Level: %d\n",
-                current_alert_status.water_level_percent,
-                current_alert_status.rain_volume_percent,
-                current_alert_status.is_alert_active,
-                current_alert_status.level);
-        } else {
-            printf("DisplayTask: DisplayAlertQueue recebido. TIMEOUT.\n");
-        }
+    // Primeiro quadro com o estado inicial do barramento (desenha a moldura)
+    state_bus_read(xDisplayAlertSub, &current_alert_status);
+    display_model_from_status(&current_alert_status, &model);
+    display_scheduler_submit(&display_sched, ssd, &model);
 
+    // Gráfico da água: uma coluna por DISPLAY_GRAPH_COLUMN_MS com o maior nível do intervalo
+    sparkline_init(&water_graph, DISPLAY_GRAPH_X, DISPLAY_GRAPH_Y, DISPLAY_GRAPH_WIDTH, DISPLAY_GRAPH_HEIGHT);
+    uint8_t graph_max = current_alert_status.water_level_percent;
+    TickType_t next_column = xTaskGetTickCount() + pdMS_TO_TICKS(DISPLAY_GRAPH_COLUMN_MS);
 
-        ssd1306_fill(ssd, false); // Limpa o display.
-        ssd1306_rect(ssd, 0, 0, 127, 63, 1, false);
-        sprintf(line1, "NVL. AGUA: %3u%%", current_alert_status.water_level_percent);
-        ssd1306_draw_string(ssd, line1, 3, 5);
-
-        sprintf(line2, "VOL. CHUVA: %2u%%", current_alert_status.rain_volume_percent);
-        ssd1306_draw_string(ssd, line2, 3, 20);
+    while (true) {
+        // Dorme até a próxima publicação ou a próxima coluna do gráfico;
+        // em regime estável o I2C só transmite a coluna nova
+        TickType_t now = xTaskGetTickCount();
+        TickType_t until_column = ((int32_t)(next_column - now) > 0) ? next_column - now : 0;
+
+        if (state_bus_wait(until_column)) {
+            // Teto de FPS: se o último quadro é recente, espera o fim do intervalo.
+            // Publicações que chegarem nesse meio tempo não geram quadros extras,
+            // pois a leitura abaixo pega sempre o estado mais recente
+            TickType_t delay = display_scheduler_delay(&display_sched);
+            if (delay > 0) {
+                vTaskDelay(delay);
+                if (state_bus_wait(0)) {
+                    display_sched.coalesced++;
+                }
+            }
 
-        if (current_alert_status.is_alert_active) {
-            strcpy(line3, "!!! ALERTA !!!");
-            switch(current_alert_status.level) {
-                case ALERT_WATER_HIGH: sprintf(line4, "Nivel Agua Alto!"); break;
-                case ALERT_RAIN_HIGH:  sprintf(line4, "Chuva Intensa!");   break;
-                case ALERT_BOTH_HIGH:  sprintf(line4, "PERIGO MAXIMO!");   break;
-                default:               sprintf(line4, "Alerta Ativo");     break;
+            state_bus_read(xDisplayAlertSub, &current_alert_status);
+            if (current_alert_status.water_level_percent > graph_max) {
+                graph_max = current_alert_status.water_level_percent;
+            }
+            display_model_from_status(&current_alert_status, &model);
+            if (display_scheduler_submit(&display_sched, ssd, &model)) {
+                state_bus_note_applied(xDisplayAlertSub, &current_alert_status);
             }
-        } else {
-            strcpy(line3, "STATUS: NORMAL");
-            strcpy(line4, ""); // Linha vazia
         }
 
-        ssd1306_draw_string(ssd, line3, 3, 35);
-        ssd1306_draw_string(ssd, line4, 3, 45);
-
-        ssd1306_send_data(ssd);
-        vTaskDelay(pdMS_TO_TICKS(DISPLAY_UPDATE_DELAY_MS));
+        if ((int32_t)(xTaskGetTickCount() - next_column) >= 0) {
+            sparkline_push(&water_graph, ssd, graph_max);
+            display_flush(ssd);
+            graph_max = current_alert_status.water_level_percent;
+            next_column += pdMS_TO_TICKS(DISPLAY_GRAPH_COLUMN_MS);
+        }
     }
-}
\ No newline at end of file
+}
+
@@ -0,0 +1,6 @@
+#ifndef HOST_SDK_HARDWARE_ADC_H
+#define HOST_SDK_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+#endif // HOST_SDK_HARDWARE_ADC_H
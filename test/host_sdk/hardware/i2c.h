@@ -0,0 +1,12 @@
+#ifndef HOST_SDK_HARDWARE_I2C_H
+#define HOST_SDK_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+// Bits de IC_DATA_CMD usados por i2c_dma.h
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u
+#define I2C_IC_DATA_CMD_STOP_BITS    0x00000200u
+
+#endif // HOST_SDK_HARDWARE_I2C_H
@@ -0,0 +1,9 @@
+#ifndef HOST_SDK_HARDWARE_PIO_H
+#define HOST_SDK_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+#endif // HOST_SDK_HARDWARE_PIO_H
@@ -0,0 +1,14 @@
+#ifndef HOST_SDK_PICO_STDLIB_H
+#define HOST_SDK_PICO_STDLIB_H
+
+// Substituto mínimo do Pico SDK para compilar config.h no host: só os tipos que os
+// cabeçalhos do projeto citam. Nenhuma função do SDK é declarada aqui; módulos que
+// falam com o hardware não entram nos testes de host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#endif // HOST_SDK_PICO_STDLIB_H
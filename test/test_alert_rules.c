@@ -0,0 +1,137 @@
+#include "test_common.h"
+#include "alert_rules.h"
+
+// Confere a tabela gerada contra a cadeia de if/else que ela substituiu, varrendo
+// os valores dos sensores em torno de todos os limiares, e mede a vazão das duas.
+
+#define BENCH_INPUTS 4096
+#define BENCH_ROUNDS 500
+#define BENCH_REPEATS 5
+
+static int tier_of(int32_t value, int32_t watch, int32_t warning, int32_t emergency) {
+    return (value >= watch) + (value >= warning) + (value >= emergency);
+}
+
+// Referência: classificação em if/else de vDataProcessingTask antes do motor de regras
+__attribute__((noinline)) static AlertRuleResult_t reference_evaluate(const int32_t v[ALERT_SENSOR_COUNT]) {
+    int water = tier_of(v[ALERT_SENSOR_WATER], WATER_LEVEL_WATCH_THRESHOLD * 10, WATER_LEVEL_ALERT_THRESHOLD * 10,
+                        WATER_LEVEL_EMERGENCY_THRESHOLD * 10);
+    int rain = tier_of(v[ALERT_SENSOR_RAIN], RAIN_VOLUME_WATCH_THRESHOLD * 10, RAIN_VOLUME_ALERT_THRESHOLD * 10,
+                       RAIN_VOLUME_EMERGENCY_THRESHOLD * 10);
+    int rise = tier_of(v[ALERT_SENSOR_RISE], TREND_WATCH_PERMILLE_PER_MIN, TREND_RAPID_RISE_PERMILLE_PER_MIN,
+                       TREND_EMERGENCY_PERMILLE_PER_MIN);
+
+    AlertRuleResult_t r = { ALERT_NONE, ALERT_SEVERITY_NONE };
+    int rule_severity = ALERT_SEVERITY_NONE;
+    if (water >= ALERT_SEVERITY_WARNING && rain >= ALERT_SEVERITY_WARNING) {
+        r.level = ALERT_BOTH_HIGH;
+        rule_severity = ALERT_SEVERITY_EMERGENCY;
+    } else if (water >= ALERT_SEVERITY_WARNING) {
+        r.level = ALERT_WATER_HIGH;
+        rule_severity = ALERT_SEVERITY_WARNING;
+    } else if (rise >= ALERT_SEVERITY_WARNING) {
+        r.level = ALERT_RAPID_RISE;
+        rule_severity = ALERT_SEVERITY_WARNING;
+    } else if (rain >= ALERT_SEVERITY_WARNING) {
+        r.level = ALERT_RAIN_HIGH;
+        rule_severity = ALERT_SEVERITY_WARNING;
+    }
+    int max_tier = water > rain ? water : rain;
+    max_tier = rise > max_tier ? rise : max_tier;
+    r.severity = (uint8_t)(max_tier > rule_severity ? max_tier : rule_severity);
+    return r;
+}
+
+static void test_generated_sizes(void) {
+    CHECK_EQ_INT(ALERT_SENSOR_COUNT_PP, ALERT_SENSOR_COUNT);
+    CHECK_EQ_INT(ALERT_LUT_SIZE, 1u << (ALERT_TIER_BITS * ALERT_SENSOR_COUNT));
+    CHECK((1 << ALERT_TIER_BITS) >= ALERT_SEVERITY_COUNT);
+}
+
+static void test_matches_reference(void) {
+    int mismatches = 0;
+    for (int32_t water = -10; water <= 1010; water += 5) {
+        for (int32_t rain = -10; rain <= 1010; rain += 5) {
+            for (int32_t rise = -1300; rise <= 1300; rise += 50) {
+                int32_t values[ALERT_SENSOR_COUNT];
+                values[ALERT_SENSOR_WATER] = water;
+                values[ALERT_SENSOR_RAIN] = rain;
+                values[ALERT_SENSOR_RISE] = rise;
+                AlertRuleResult_t got = alert_rules_evaluate(values);
+                AlertRuleResult_t want = reference_evaluate(values);
+                if (got.level != want.level || got.severity != want.severity) {
+                    if (mismatches++ < 5) {
+                        fprintf(stderr, "água %d chuva %d subida %d: %d/%d, esperado %d/%d\n",
+                                water, rain, rise, got.level, got.severity, want.level, want.severity);
+                    }
+                }
+            }
+        }
+    }
+    CHECK_EQ_INT(mismatches, 0);
+
+    // Exatamente nos limiares (>=) e logo abaixo
+    int32_t at[ALERT_SENSOR_COUNT] = { 0 };
+    at[ALERT_SENSOR_WATER] = WATER_LEVEL_ALERT_THRESHOLD * 10;
+    CHECK_EQ_INT(alert_rules_evaluate(at).level, ALERT_WATER_HIGH);
+    at[ALERT_SENSOR_WATER] -= 1;
+    CHECK_EQ_INT(alert_rules_evaluate(at).level, ALERT_NONE);
+    CHECK_EQ_INT(alert_rules_evaluate(at).severity, ALERT_SEVERITY_WATCH);
+}
+
+// Gerador pseudoaleatório fixo, para o benchmark ser repetível
+static uint32_t lcg_next(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static void bench_throughput(void) {
+    static int32_t inputs[BENCH_INPUTS][ALERT_SENSOR_COUNT];
+    uint32_t seed = 12345;
+    for (int i = 0; i < BENCH_INPUTS; ++i) {
+        inputs[i][ALERT_SENSOR_WATER] = (int32_t)(lcg_next(&seed) % 1001);
+        inputs[i][ALERT_SENSOR_RAIN] = (int32_t)(lcg_next(&seed) % 1001);
+        inputs[i][ALERT_SENSOR_RISE] = (int32_t)(lcg_next(&seed) % 3001) - 1500;
+    }
+
+    // Melhor de BENCH_REPEATS medições de cada caminho, para reduzir o ruído do host
+    uint64_t chain_ns = UINT64_MAX, lut_ns = UINT64_MAX;
+    for (int repeat = 0; repeat < BENCH_REPEATS; ++repeat) {
+        uint32_t sum = 0;
+        uint64_t start = test_now_ns();
+        for (int round = 0; round < BENCH_ROUNDS; ++round) {
+            for (int i = 0; i < BENCH_INPUTS; ++i) {
+                AlertRuleResult_t r = reference_evaluate(inputs[i]);
+                sum += r.level + r.severity;
+            }
+        }
+        uint64_t elapsed = test_now_ns() - start;
+        chain_ns = elapsed < chain_ns ? elapsed : chain_ns;
+        test_sink = sum;
+
+        sum = 0;
+        start = test_now_ns();
+        for (int round = 0; round < BENCH_ROUNDS; ++round) {
+            for (int i = 0; i < BENCH_INPUTS; ++i) {
+                AlertRuleResult_t r = alert_rules_evaluate(inputs[i]);
+                sum += r.level + r.severity;
+            }
+        }
+        elapsed = test_now_ns() - start;
+        lut_ns = elapsed < lut_ns ? elapsed : lut_ns;
+        test_sink = sum;
+    }
+
+    double evaluations = (double)BENCH_ROUNDS * BENCH_INPUTS;
+    printf("tabela: %u entradas de %zu bytes (%u sensores, %u bits cada)\n",
+           ALERT_LUT_SIZE, sizeof(AlertRuleResult_t), (unsigned)ALERT_SENSOR_COUNT, ALERT_TIER_BITS);
+    printf("if/else: %.1f M avaliações/s\n", evaluations / (double)chain_ns * 1e3);
+    printf("tabela:  %.1f M avaliações/s\n", evaluations / (double)lut_ns * 1e3);
+}
+
+int main(void) {
+    test_generated_sizes();
+    test_matches_reference();
+    bench_throughput();
+    return TEST_RESULT();
+}
@@ -0,0 +1,45 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+// Apoio mínimo aos testes de host: cada CHECK que falha é impresso e contado,
+// e o main() do teste retorna TEST_RESULT() (0 = tudo certo) para o ctest.
+
+static int test_failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);   \
+            test_failures++;                                                     \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ_INT(actual, expected)                                           \
+    do {                                                                         \
+        long long a_ = (long long)(actual), e_ = (long long)(expected);          \
+        if (a_ != e_) {                                                          \
+            fprintf(stderr, "%s:%d: %s = %lld, esperado %lld\n",                 \
+                    __FILE__, __LINE__, #actual, a_, e_);                        \
+            test_failures++;                                                     \
+        }                                                                        \
+    } while (0)
+
+#define TEST_RESULT()                                                            \
+    (test_failures == 0 ? (printf("ok\n"), 0)                                    \
+                        : (printf("%d falha(s)\n", test_failures), 1))
+
+// Relógio monotônico em nanossegundos, para os benchmarks
+static inline uint64_t test_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Impede que o compilador descarte um resultado calculado só para medir tempo
+static volatile uint32_t test_sink;
+
+#endif // TEST_COMMON_H
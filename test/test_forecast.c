@@ -0,0 +1,135 @@
+#include "test_common.h"
+#include "forecast.h"
+
+// Reproduz rampas sintéticas (nível subindo em ritmo constante, com ruído de
+// leitura) por forecast_update(), compara a previsão de tempo até o limiar com o
+// instante real de cruzamento e mede o custo por atualização.
+
+#define RATE_HZ        20   // SENSOR_OUTPUT_RATE_HZ
+#define ALPHA_SHIFT    3    // FORECAST_ALPHA_SHIFT
+#define BETA_SHIFT     6    // FORECAST_BETA_SHIFT
+#define HORIZON_S      300  // FORECAST_HORIZON_S
+#define THRESHOLD      700  // WATER_LEVEL_ALERT_THRESHOLD em permilagem
+#define SETTLE_S       10   // Previsões só são avaliadas depois desse tempo de rampa (~3 constantes de tempo da tendência)
+#define NEAR_S         30   // Perto do cruzamento a tolerância é mais apertada
+#define BENCH_UPDATES  (20 * 1000 * 1000)
+
+typedef struct {
+    const char *name;
+    int32_t start;             // Nível inicial (permilagem)
+    int32_t rise_per_min;      // Subida (permilagem por minuto)
+    int32_t noise;             // Ruído uniforme de ±noise
+} ramp_case_t;
+
+static const ramp_case_t ramps[] = {
+    { "lenta 12%/min",      300,  120, 5 },
+    { "media 30%/min",      300,  300, 8 },
+    { "rapida 60%/min",     300,  600, 10 },
+    { "enxurrada 120%/min", 300, 1200, 10 },
+};
+
+// O ruído na tendência gera um erro proporcional à antecedência: aceitam-se 2 s
+// mais metade do tempo restante, ou mais um terço dele nos últimos NEAR_S segundos.
+static int32_t tolerance_s(int32_t truth) {
+    return 2 + (truth <= NEAR_S ? truth / 3 : truth / 2);
+}
+
+static uint32_t lcg_state = 1;
+static int32_t noise_sample(int32_t amplitude) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return amplitude == 0 ? 0 : (int32_t)((lcg_state >> 8) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+static void replay_ramp(const ramp_case_t *rc) {
+    forecast_t f;
+    forecast_init(&f, ALPHA_SHIFT, BETA_SHIFT);
+
+    // Amostra (em vinte avos de segundo) em que a rampa sem ruído cruza o limiar
+    int64_t crossing = ((int64_t)(THRESHOLD - rc->start) * 60 * RATE_HZ + rc->rise_per_min - 1) / rc->rise_per_min;
+
+    int32_t worst_near = 0, checked = 0;
+    int64_t abs_sum = 0, rel_sum_pct = 0;
+    for (int64_t i = 0; i < crossing; ++i) {
+        int32_t level = rc->start + (int32_t)(i * rc->rise_per_min / (60 * RATE_HZ));
+        forecast_update(&f, level + noise_sample(rc->noise));
+
+        if (i < SETTLE_S * RATE_HZ || i % RATE_HZ != 0) {
+            continue;
+        }
+        int32_t truth = (int32_t)((crossing - i) / RATE_HZ);
+        int32_t eta = forecast_seconds_to(&f, THRESHOLD, RATE_HZ, HORIZON_S);
+        if (truth > HORIZON_S) {
+            continue; // Fora do horizonte: a previsão pode ser descartada
+        }
+        CHECK(eta != FORECAST_NO_ESTIMATE);
+        int32_t error = eta - truth;
+        if (error < 0) error = -error;
+        if (error > tolerance_s(truth)) {
+            fprintf(stderr, "%s: faltando %d s, previsão %d s\n", rc->name, truth, eta);
+            test_failures++;
+        }
+        if (truth <= NEAR_S && error > worst_near) {
+            worst_near = error;
+        }
+        abs_sum += error;
+        rel_sum_pct += truth > 0 ? (int64_t)error * 100 / truth : 0;
+        checked++;
+    }
+    printf("%-20s cruza em %4lld s, %3d previsões, erro médio %.1f s (%.0f%%), pior nos últimos %d s: %d s\n",
+           rc->name, (long long)(crossing / RATE_HZ), checked,
+           checked ? (double)abs_sum / checked : 0.0, checked ? (double)rel_sum_pct / checked : 0.0,
+           NEAR_S, worst_near);
+    CHECK(checked > 0);
+
+    // Depois de cruzar, a previsão é 0
+    for (int i = 0; i < 5 * RATE_HZ; ++i) {
+        forecast_update(&f, THRESHOLD + 50 + noise_sample(rc->noise));
+    }
+    CHECK_EQ_INT(forecast_seconds_to(&f, THRESHOLD, RATE_HZ, HORIZON_S), 0);
+}
+
+// Nível estável ou descendo: sem previsão
+static void test_no_estimate(void) {
+    forecast_t f;
+    forecast_init(&f, ALPHA_SHIFT, BETA_SHIFT);
+    CHECK_EQ_INT(forecast_seconds_to(&f, THRESHOLD, RATE_HZ, HORIZON_S), FORECAST_NO_ESTIMATE);
+    for (int i = 0; i < 60 * RATE_HZ; ++i) {
+        forecast_update(&f, 400);
+    }
+    CHECK_EQ_INT(forecast_seconds_to(&f, THRESHOLD, RATE_HZ, HORIZON_S), FORECAST_NO_ESTIMATE);
+    for (int i = 0; i < 60 * RATE_HZ; ++i) {
+        forecast_update(&f, 400 - i / 10);
+    }
+    CHECK_EQ_INT(forecast_seconds_to(&f, THRESHOLD, RATE_HZ, HORIZON_S), FORECAST_NO_ESTIMATE);
+}
+
+static void bench_update(void) {
+    forecast_t f;
+    forecast_init(&f, ALPHA_SHIFT, BETA_SHIFT);
+    uint64_t start = test_now_ns();
+    for (int32_t i = 0; i < BENCH_UPDATES; ++i) {
+        forecast_update(&f, 300 + (i & 0x1FF));
+    }
+    uint64_t update_ns = test_now_ns() - start;
+    test_sink = (uint32_t)f.level_q16;
+
+    uint32_t sum = 0;
+    start = test_now_ns();
+    for (int32_t i = 0; i < BENCH_UPDATES / 10; ++i) {
+        sum += (uint32_t)forecast_seconds_to(&f, THRESHOLD + (i & 0xFF), RATE_HZ, HORIZON_S);
+    }
+    uint64_t eta_ns = test_now_ns() - start;
+    test_sink = sum;
+
+    printf("forecast_update:     %.2f ns\n", (double)update_ns / BENCH_UPDATES);
+    printf("forecast_seconds_to: %.2f ns\n", (double)eta_ns / (BENCH_UPDATES / 10));
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(ramps) / sizeof(ramps[0]); ++i) {
+        replay_ramp(&ramps[i]);
+    }
+    test_no_estimate();
+    bench_update();
+    return TEST_RESULT();
+}
@@ -0,0 +1,126 @@
+#include <math.h>
+#include "test_common.h"
+#include "led_color.h"
+
+// Tabela de gama e brilho (led_color.c) contra a curva calculada em ponto
+// flutuante, e benchmark em pixels/s da conversão antiga da matriz (cores em
+// float, multiplicadas pelo brilho e saturadas a cada pixel) contra a tabela.
+
+// --- Conversão antiga (led_matrix.c antes da tabela) ---
+
+typedef struct {
+    float r;
+    float g;
+    float b;
+} float_color_t;
+
+static inline uint32_t float_color_to_grb(float_color_t color, float brightness) {
+    brightness = fmaxf(0.0f, fminf(1.0f, brightness));
+    float r = fmaxf(0.0f, fminf(1.0f, color.r * brightness));
+    float g = fmaxf(0.0f, fminf(1.0f, color.g * brightness));
+    float b = fmaxf(0.0f, fminf(1.0f, color.b * brightness));
+
+    uint8_t r8 = (uint8_t)(r * 255.0f + 0.3f);
+    uint8_t g8 = (uint8_t)(g * 255.0f + 0.3f);
+    uint8_t b8 = (uint8_t)(b * 255.0f + 0.3f);
+    return ((uint32_t)g8 << 24) | ((uint32_t)r8 << 16) | ((uint32_t)b8 << 8);
+}
+
+// Paleta da matriz nas duas representações
+#define PALETTE_SIZE 7
+static const float_color_t float_palette[PALETTE_SIZE] = {
+    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.8f, 0.8f, 0.0f}, {0.0f, 0.3f, 1.0f},
+    {1.0f, 0.4f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.7f, 0.7f},
+};
+static led_color_t lut_palette[PALETTE_SIZE];
+
+// --- Correção ---
+
+static void test_lut_matches_curve(void) {
+    static const uint8_t brightness_levels[] = { 0, 1, 38, 128, 200, 255 };
+    led_color_lut_t lut;
+    for (size_t k = 0; k < sizeof(brightness_levels); ++k) {
+        uint8_t brightness = brightness_levels[k];
+        led_color_lut_build(&lut, brightness);
+        CHECK_EQ_INT(lut.brightness, brightness);
+        CHECK_EQ_INT(lut.level[0], 0);
+        CHECK_EQ_INT(lut.level[255], brightness);
+        for (int i = 0; i < 256; ++i) {
+            // Gama arredondada a 8 bits e depois escalada: até 1 de diferença da curva exata
+            double exact = 255.0 * pow(i / 255.0, LED_COLOR_GAMMA_X10 / 10.0) * brightness / 255.0;
+            CHECK(fabs(lut.level[i] - exact) <= 1.0);
+            if (i > 0) {
+                CHECK(lut.level[i] >= lut.level[i - 1]); // Monotônica
+            }
+        }
+    }
+}
+
+static void test_grb_layout(void) {
+    led_color_lut_t lut;
+    led_color_lut_build(&lut, 255);
+    led_color_t color = { 255, 128, 1 };
+    uint32_t word = led_color_to_grb(&lut, color);
+    CHECK_EQ_INT((word >> 24) & 0xFF, lut.level[128]); // G
+    CHECK_EQ_INT((word >> 16) & 0xFF, lut.level[255]); // R
+    CHECK_EQ_INT((word >> 8) & 0xFF, lut.level[1]);    // B
+    CHECK_EQ_INT(word & 0xFF, 0);                      // Bits 7-0 não são enviados
+}
+
+// --- Benchmark ---
+
+#define FRAME_PIXELS 25 // Matriz 5x5
+#define FRAMES       400000
+
+static uint32_t frame[FRAME_PIXELS];
+
+static double bench_float(float brightness) {
+    uint64_t start = test_now_ns();
+    for (int f = 0; f < FRAMES; ++f) {
+        for (int i = 0; i < FRAME_PIXELS; ++i) {
+            frame[i] = float_color_to_grb(float_palette[(f + i) % PALETTE_SIZE], brightness);
+        }
+        test_sink += frame[f % FRAME_PIXELS];
+    }
+    return (double)(test_now_ns() - start);
+}
+
+static double bench_lut(const led_color_lut_t *lut) {
+    uint64_t start = test_now_ns();
+    for (int f = 0; f < FRAMES; ++f) {
+        for (int i = 0; i < FRAME_PIXELS; ++i) {
+            frame[i] = led_color_to_grb(lut, lut_palette[(f + i) % PALETTE_SIZE]);
+        }
+        test_sink += frame[f % FRAME_PIXELS];
+    }
+    return (double)(test_now_ns() - start);
+}
+
+static void bench_conversion(void) {
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
+        lut_palette[i].r = (uint8_t)(float_palette[i].r * 255.0f + 0.5f);
+        lut_palette[i].g = (uint8_t)(float_palette[i].g * 255.0f + 0.5f);
+        lut_palette[i].b = (uint8_t)(float_palette[i].b * 255.0f + 0.5f);
+    }
+    led_color_lut_t lut;
+    led_color_lut_build(&lut, 38); // ~0,15, o brilho global antigo
+
+    // Melhor de 5 rodadas
+    double float_ns = 0, lut_ns = 0;
+    for (int run = 0; run < 5; ++run) {
+        double f = bench_float(0.15f);
+        double l = bench_lut(&lut);
+        if (run == 0 || f < float_ns) float_ns = f;
+        if (run == 0 || l < lut_ns) lut_ns = l;
+    }
+    double pixels = (double)FRAMES * FRAME_PIXELS;
+    printf("float: %.1f Mpixels/s   tabela: %.1f Mpixels/s   (x%.1f)\n",
+           pixels / float_ns * 1e3, pixels / lut_ns * 1e3, float_ns / lut_ns);
+}
+
+int main(void) {
+    test_lut_matches_curve();
+    test_grb_layout();
+    bench_conversion();
+    return TEST_RESULT();
+}
@@ -0,0 +1,159 @@
+#include <string.h>
+#include "test_common.h"
+#include "led_layout.h"
+#include "matrix_bitmap.h"
+
+// Geometria das saídas de LEDs (led_layout.c): posições conhecidas, bijeção em
+// todas as combinações de flags, tabelas explícitas e a matriz 5x5 da placa.
+// Os ícones (matrix_bitmap.h) são desenhados na ordem da imagem e permutados pela
+// tabela da geometria, como em led_strip_show(); o resultado na fita deve ser o
+// mesmo da antiga máscara com a serpentina fixa no código.
+
+// Montagem da matriz da placa (igual a matrix_layout em led_matrix.c)
+static const led_layout_t board_matrix = {
+    5, 5, LED_LAYOUT_ORIGIN_RIGHT | LED_LAYOUT_ORIGIN_BOTTOM | LED_LAYOUT_SERPENTINE, NULL };
+
+// Posição na fita de cada (x, y) na placa: LED 0 embaixo à direita, serpentina
+static const uint8_t board_positions[5][5] = {
+    {24, 23, 22, 21, 20},
+    {15, 16, 17, 18, 19},
+    {14, 13, 12, 11, 10},
+    { 5,  6,  7,  8,  9},
+    { 4,  3,  2,  1,  0},
+};
+
+// Máscara antiga, já na ordem da fita da placa (matrix_bitmap.h antes da geometria)
+#define OLD_FRAME(r0, r1, r2, r3, r4) \
+    (((uint32_t)(r4) << 0) | ((uint32_t)MATRIX_ROW_REVERSED(r3) << 5) | ((uint32_t)(r2) << 10) | \
+     ((uint32_t)MATRIX_ROW_REVERSED(r1) << 15) | ((uint32_t)(r0) << 20))
+
+static void test_board_matrix(void) {
+    CHECK_EQ_INT(led_layout_count(&board_matrix), 25);
+    CHECK(led_layout_is_bijective(&board_matrix));
+    for (uint16_t y = 0; y < 5; ++y) {
+        for (uint16_t x = 0; x < 5; ++x) {
+            CHECK_EQ_INT(led_layout_index(&board_matrix, x, y), board_positions[y][x]);
+        }
+    }
+    CHECK_EQ_INT(led_layout_index(&board_matrix, 5, 0), LED_LAYOUT_NONE);
+    CHECK_EQ_INT(led_layout_index(&board_matrix, 0, 5), LED_LAYOUT_NONE);
+}
+
+// Aplica a tabela a uma máscara na ordem da imagem, como led_strip_show() faz com os pixels
+static uint32_t mask_to_strip(const uint16_t *map, uint32_t image_mask) {
+    led_color_t pixels[25];
+    led_color_t strip[25];
+    const led_color_t on = { 1, 1, 1 };
+    memset(pixels, 0, sizeof(pixels));
+    matrix_bitmap_fill(pixels, image_mask, on);
+    for (int i = 0; i < 25; ++i) {
+        strip[map[i]] = pixels[i];
+    }
+    uint32_t strip_mask = 0;
+    for (int i = 0; i < 25; ++i) {
+        if (strip[i].r) strip_mask |= 1u << i;
+    }
+    return strip_mask;
+}
+
+static void test_icons_through_layout(void) {
+    uint16_t map[25];
+    led_layout_build_map(&board_matrix, map);
+
+    // Um pixel por vez: o bit y * 5 + x acende o LED da posição (x, y)
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 5; ++x) {
+            uint32_t rows[5] = {0};
+            rows[y] = 1u << (4 - x);
+            uint32_t image = MATRIX_FRAME(rows[0], rows[1], rows[2], rows[3], rows[4]);
+            CHECK_EQ_INT(image, 1u << (y * 5 + x));
+            CHECK_EQ_INT(mask_to_strip(map, image), 1u << board_positions[y][x]);
+        }
+    }
+
+    // Ícones quaisquer: mesma fita que a máscara antiga
+    uint32_t state = 7;
+    for (int n = 0; n < 2000; ++n) {
+        uint32_t rows[5];
+        for (int r = 0; r < 5; ++r) {
+            state = state * 1664525u + 1013904223u;
+            rows[r] = (state >> 16) & 0x1F;
+        }
+        uint32_t image = MATRIX_FRAME(rows[0], rows[1], rows[2], rows[3], rows[4]);
+        CHECK_EQ_INT(mask_to_strip(map, image), OLD_FRAME(rows[0], rows[1], rows[2], rows[3], rows[4]));
+    }
+
+    // Linhas de água: as de baixo, que na fita da placa são os primeiros LEDs
+    for (int rows = 0; rows <= 5; ++rows) {
+        CHECK_EQ_INT(mask_to_strip(map, MATRIX_BOTTOM_ROWS(rows)), (1u << (5 * rows)) - 1);
+    }
+}
+
+static void test_all_flag_combinations(void) {
+    for (uint8_t flags = 0; flags < 16; ++flags) {
+        led_layout_t panel = { 16, 8, flags, NULL };
+        led_layout_t strip = { 32, 1, flags, NULL };
+        led_layout_t tall = { 3, 7, flags, NULL };
+        CHECK(led_layout_is_bijective(&panel));
+        CHECK(led_layout_is_bijective(&strip));
+        CHECK(led_layout_is_bijective(&tall));
+
+        // O LED 0 fica no canto indicado pelas flags
+        uint16_t x0 = (flags & LED_LAYOUT_ORIGIN_RIGHT) ? 15 : 0;
+        uint16_t y0 = (flags & LED_LAYOUT_ORIGIN_BOTTOM) ? 7 : 0;
+        CHECK_EQ_INT(led_layout_index(&panel, x0, y0), 0);
+    }
+}
+
+static void test_known_positions(void) {
+    // Colunas em serpentina: desce a coluna 0, sobe a coluna 1
+    led_layout_t columns = { 4, 3, LED_LAYOUT_COLUMNS | LED_LAYOUT_SERPENTINE, NULL };
+    CHECK_EQ_INT(led_layout_index(&columns, 0, 0), 0);
+    CHECK_EQ_INT(led_layout_index(&columns, 0, 2), 2);
+    CHECK_EQ_INT(led_layout_index(&columns, 1, 2), 3);
+    CHECK_EQ_INT(led_layout_index(&columns, 1, 0), 5);
+
+    // Linhas progressivas: todas no mesmo sentido
+    led_layout_t rows = { 4, 3, 0, NULL };
+    CHECK_EQ_INT(led_layout_index(&rows, 3, 0), 3);
+    CHECK_EQ_INT(led_layout_index(&rows, 0, 1), 4);
+
+    // Fita linear ligada pela direita
+    led_layout_t line = { 10, 1, LED_LAYOUT_ORIGIN_RIGHT, NULL };
+    CHECK_EQ_INT(led_layout_index(&line, 0, 0), 9);
+    CHECK_EQ_INT(led_layout_index(&line, 9, 0), 0);
+}
+
+static void test_explicit_map(void) {
+    static uint16_t map[32 * 8];
+    led_layout_t sign = { 32, 8, LED_LAYOUT_COLUMNS | LED_LAYOUT_SERPENTINE, NULL };
+    led_layout_build_map(&sign, map);
+    led_layout_t mapped = { 32, 8, 0, map };
+    CHECK(led_layout_is_bijective(&mapped));
+    for (uint16_t y = 0; y < 8; ++y) {
+        for (uint16_t x = 0; x < 32; ++x) {
+            CHECK_EQ_INT(led_layout_index(&mapped, x, y), led_layout_index(&sign, x, y));
+        }
+    }
+
+    // Tabelas inválidas: LED repetido ou fora da fita
+    uint16_t repeated[4] = { 0, 1, 1, 3 };
+    uint16_t outside[4] = { 0, 1, 2, 4 };
+    led_layout_t bad_repeated = { 2, 2, 0, repeated };
+    led_layout_t bad_outside = { 2, 2, 0, outside };
+    CHECK(!led_layout_is_bijective(&bad_repeated));
+    CHECK(!led_layout_is_bijective(&bad_outside));
+
+    // Acima de 1024 LEDs a verificação não se aplica
+    led_layout_t huge = { 64, 32, 0, NULL };
+    CHECK(!led_layout_is_bijective(&huge));
+}
+
+int main(void) {
+    test_board_matrix();
+    test_icons_through_layout();
+    test_all_flag_combinations();
+    test_known_positions();
+    test_explicit_map();
+    return TEST_RESULT();
+}
@@ -0,0 +1,156 @@
+#include <string.h>
+#include "test_common.h"
+#include "sample_ring.h"
+
+// Testes do anel ping-pong com fluxos sintéticos: o produtor faz o papel da ISR
+// do DMA (preenche o bloco em escrita e chama sample_ring_commit) e o consumidor
+// o de adc_capture_wait_block()/adc_capture_release_block().
+
+#define BLOCK_SAMPLES 16
+#define CHANNELS      2
+
+static uint16_t storage[SAMPLE_RING_BLOCKS][BLOCK_SAMPLES * CHANNELS];
+
+// Amostra sintética: canal 0 é uma rampa, canal 1 a rampa invertida (12 bits)
+static uint16_t synthetic_sample(uint32_t n, uint8_t channel) {
+    uint16_t ramp = (uint16_t)((n * 37u) & 0x0FFFu);
+    return channel == 0 ? ramp : (uint16_t)(0x0FFFu - ramp);
+}
+
+// Preenche o bloco em escrita a partir da amostra `first` e o entrega
+static uint8_t produce_block(sample_ring_t *ring, uint32_t first) {
+    uint16_t *block = sample_ring_block(ring, ring->write_block);
+    for (uint16_t i = 0; i < BLOCK_SAMPLES; ++i) {
+        for (uint8_t c = 0; c < CHANNELS; ++c) {
+            block[i * CHANNELS + c] = synthetic_sample(first + i, c);
+        }
+    }
+    return sample_ring_commit(ring);
+}
+
+// Confere um bloco recebido contra o fluxo sintético
+static void check_block(const uint16_t *block, uint32_t first) {
+    uint32_t sum[CHANNELS] = {0};
+    for (uint16_t i = 0; i < BLOCK_SAMPLES; ++i) {
+        for (uint8_t c = 0; c < CHANNELS; ++c) {
+            CHECK_EQ_INT(block[i * CHANNELS + c], synthetic_sample(first + i, c));
+            sum[c] += synthetic_sample(first + i, c);
+        }
+    }
+    for (uint8_t c = 0; c < CHANNELS; ++c) {
+        uint16_t mean = (uint16_t)((sum[c] + BLOCK_SAMPLES / 2) / BLOCK_SAMPLES);
+        CHECK_EQ_INT(sample_ring_channel_mean(block, BLOCK_SAMPLES, CHANNELS, c), mean);
+    }
+}
+
+static void test_layout(void) {
+    sample_ring_t ring;
+    sample_ring_init(&ring, &storage[0][0], BLOCK_SAMPLES, CHANNELS);
+    CHECK_EQ_INT(sample_ring_block_words(&ring), BLOCK_SAMPLES * CHANNELS);
+    CHECK(sample_ring_block(&ring, 0) == storage[0]);
+    CHECK(sample_ring_block(&ring, 1) == storage[1]);
+    CHECK(sample_ring_acquire(&ring) == NULL);
+}
+
+// Consumidor acompanha o produtor: cada bloco chega uma vez, em ordem, sem overrun
+static void test_lockstep_stream(void) {
+    sample_ring_t ring;
+    sample_ring_init(&ring, &storage[0][0], BLOCK_SAMPLES, CHANNELS);
+    for (uint32_t n = 0; n < 100; ++n) {
+        uint8_t completed = produce_block(&ring, n * BLOCK_SAMPLES);
+        CHECK_EQ_INT(completed, n % SAMPLE_RING_BLOCKS);
+        const uint16_t *block = sample_ring_acquire(&ring);
+        CHECK(block == storage[n % SAMPLE_RING_BLOCKS]);
+        if (block != NULL) {
+            check_block(block, n * BLOCK_SAMPLES);
+        }
+        sample_ring_release(&ring);
+        CHECK(sample_ring_acquire(&ring) == NULL);
+    }
+    CHECK_EQ_INT(ring.blocks_completed, 100);
+    CHECK_EQ_INT(ring.overruns, 0);
+}
+
+// Consumidor atrasado um bloco: os dois blocos ficam prontos, mas o mais antigo
+// (em write_block) já está sendo reescrito pelo DMA encadeado. Ele é descartado e
+// contado como overrun, e sai o último bloco concluído.
+static void test_two_ready_blocks_keep_newest(void) {
+    sample_ring_t ring;
+    sample_ring_init(&ring, &storage[0][0], BLOCK_SAMPLES, CHANNELS);
+    produce_block(&ring, 0);
+    produce_block(&ring, BLOCK_SAMPLES);
+    CHECK_EQ_INT(ring.overruns, 0);
+    CHECK_EQ_INT(ring.write_block, 0);
+
+    const uint16_t *block = sample_ring_acquire(&ring);
+    CHECK(block == storage[1]);
+    if (block != NULL) {
+        check_block(block, BLOCK_SAMPLES);
+    }
+    CHECK_EQ_INT(ring.overruns, 1);
+    CHECK_EQ_INT(ring.ready[0], 0);
+    sample_ring_release(&ring);
+    CHECK(sample_ring_acquire(&ring) == NULL);
+
+    // O bloco descartado volta quando o produtor o conclui, sem contar de novo
+    produce_block(&ring, 2 * BLOCK_SAMPLES);
+    CHECK_EQ_INT(ring.overruns, 1);
+    block = sample_ring_acquire(&ring);
+    CHECK(block == storage[0]);
+    if (block != NULL) {
+        check_block(block, 2 * BLOCK_SAMPLES);
+    }
+    sample_ring_release(&ring);
+}
+
+// Consumidor parado: cada bloco além dos dois pendentes conta como overrun, e o
+// pendente em reescrita também
+static void test_overrun_counting(void) {
+    sample_ring_t ring;
+    sample_ring_init(&ring, &storage[0][0], BLOCK_SAMPLES, CHANNELS);
+    for (uint32_t n = 0; n < 7; ++n) {
+        produce_block(&ring, n * BLOCK_SAMPLES);
+    }
+    CHECK_EQ_INT(ring.blocks_completed, 7);
+    CHECK_EQ_INT(ring.overruns, 7 - SAMPLE_RING_BLOCKS);
+
+    // Sai só o último bloco concluído (amostras 6); o da amostra 5 está em reescrita
+    const uint16_t *newest = sample_ring_acquire(&ring);
+    CHECK(newest != NULL);
+    if (newest != NULL) {
+        check_block(newest, 6 * BLOCK_SAMPLES);
+    }
+    CHECK_EQ_INT(ring.overruns, 7 - SAMPLE_RING_BLOCKS + 1);
+    sample_ring_release(&ring);
+    CHECK(sample_ring_acquire(&ring) == NULL);
+
+    // Depois disso, o fluxo volta ao normal sem novos overruns
+    uint32_t overruns = ring.overruns;
+    for (uint32_t n = 0; n < 10; ++n) {
+        produce_block(&ring, n * BLOCK_SAMPLES);
+        const uint16_t *block = sample_ring_acquire(&ring);
+        CHECK(block != NULL);
+        if (block != NULL) {
+            check_block(block, n * BLOCK_SAMPLES);
+        }
+        sample_ring_release(&ring);
+    }
+    CHECK_EQ_INT(ring.overruns, overruns);
+}
+
+static void test_channel_mean_edges(void) {
+    const uint16_t block[] = { 4095, 0, 4095, 1, 4094, 0 };
+    CHECK_EQ_INT(sample_ring_channel_mean(block, 3, 2, 0), 4095); // 12284/3 = 4094,67 arredonda para cima
+    CHECK_EQ_INT(sample_ring_channel_mean(block, 3, 2, 1), 0);    // 1/3 arredonda para baixo
+    CHECK_EQ_INT(sample_ring_channel_mean(block, 0, 2, 0), 0);
+}
+
+int main(void) {
+    memset(storage, 0, sizeof(storage));
+    test_layout();
+    test_lockstep_stream();
+    test_two_ready_blocks_keep_newest();
+    test_overrun_counting();
+    test_channel_mean_edges();
+    return TEST_RESULT();
+}
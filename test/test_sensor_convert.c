@@ -0,0 +1,114 @@
+#include "test_common.h"
+#include "sensor_convert.h"
+
+// Equivalência da conversão inteira com o caminho em ponto flutuante original de
+// vJoystickReadTask, em todas as 4096 leituras de 12 bits, e benchmark dos dois.
+// A referência é a divisão inteira exata; onde o float diverge dela (resultado como
+// 52,999996% truncado para 52), o erro é do float e é listado, não contado como falha.
+
+#define ADC_CODES    4096
+#define BENCH_ROUNDS 2000
+
+// Faixas de calibração testadas; a primeira é ADC_MIN_VALUE/ADC_MAX_VALUE de config.h
+static const uint16_t calibrations[][2] = {
+    { 0, 4095 }, { 100, 4000 }, { 7, 3000 }, { 2000, 2001 }, { 0, 1 },
+};
+#define CALIBRATION_COUNT (sizeof(calibrations) / sizeof(calibrations[0]))
+
+// Caminho original: clamp, divisão e multiplicação em float, truncado para uint8_t.
+// Fora de linha, como sensor_convert_permille() (outra unidade de compilação).
+__attribute__((noinline)) static uint8_t float_percent(uint16_t raw, uint16_t raw_min, uint16_t raw_max) {
+    uint16_t value = raw < raw_min ? raw_min : (raw > raw_max ? raw_max : raw);
+    float percent = 0.0f;
+    if ((raw_max - raw_min) != 0) {
+        percent = ((float)(value - raw_min) / (raw_max - raw_min)) * 100.0f;
+    }
+    uint8_t result = (uint8_t)percent;
+    return result > 100 ? 100 : result;
+}
+
+// Referência exata: floor((raw - min) * 1000 / span), com a leitura limitada à faixa
+static uint16_t exact_permille(uint32_t offset_num, uint32_t offset_den, uint16_t span) {
+    return (uint16_t)((uint64_t)offset_num * SENSOR_PERMILLE_FULL_SCALE / ((uint64_t)span * offset_den));
+}
+
+static void test_equivalence_all_codes(void) {
+    for (size_t k = 0; k < CALIBRATION_COUNT; ++k) {
+        uint16_t raw_min = calibrations[k][0];
+        uint16_t raw_max = calibrations[k][1];
+        sensor_convert_t conv;
+        sensor_convert_init(&conv, raw_min, raw_max);
+
+        int mismatches = 0;
+        for (uint32_t raw = 0; raw < ADC_CODES; ++raw) {
+            uint16_t clamped = raw < raw_min ? raw_min : (raw > raw_max ? raw_max : (uint16_t)raw);
+            uint16_t permille = sensor_convert_permille(&conv, (uint16_t)raw);
+            uint8_t percent = sensor_permille_to_percent(permille);
+            uint8_t exact_percent = (uint8_t)(exact_permille(clamped - raw_min, 1, conv.span) / 10);
+            if (permille != exact_permille(clamped - raw_min, 1, conv.span) || percent != exact_percent) {
+                mismatches++;
+            }
+            uint8_t float_result = float_percent((uint16_t)raw, raw_min, raw_max);
+            if (float_result != percent) {
+                // Só é aceitável quando o float é que erra
+                CHECK(float_result != exact_percent);
+                printf("faixa %u-%u, leitura %u: float %u%%, exato %u%%\n",
+                       raw_min, raw_max, (unsigned)raw, float_result, exact_percent);
+            }
+        }
+        // Leituras filtradas em Q4: todas as 65536 entradas
+        for (uint32_t q4 = 0; q4 <= 0xFFFFu; ++q4) {
+            uint32_t min_q4 = (uint32_t)raw_min << SENSOR_Q4_FRAC_BITS;
+            uint32_t max_q4 = (uint32_t)raw_max << SENSOR_Q4_FRAC_BITS;
+            uint32_t clamped = q4 < min_q4 ? min_q4 : (q4 > max_q4 ? max_q4 : q4);
+            uint16_t expected = exact_permille(clamped - min_q4, 1u << SENSOR_Q4_FRAC_BITS, conv.span);
+            if (sensor_convert_permille_q4(&conv, (uint16_t)q4) != expected) {
+                mismatches++;
+            }
+        }
+        if (mismatches != 0) {
+            fprintf(stderr, "faixa %u-%u: %d divergências\n", raw_min, raw_max, mismatches);
+        }
+        CHECK_EQ_INT(mismatches, 0);
+    }
+
+    for (uint16_t permille = 0; permille <= SENSOR_PERMILLE_FULL_SCALE; ++permille) {
+        CHECK_EQ_INT(sensor_permille_to_percent(permille), permille / 10);
+    }
+}
+
+static void bench_conversion(void) {
+    sensor_convert_t conv;
+    sensor_convert_init(&conv, calibrations[0][0], calibrations[0][1]);
+
+    uint32_t sum = 0;
+    uint64_t start = test_now_ns();
+    for (int round = 0; round < BENCH_ROUNDS; ++round) {
+        for (uint16_t raw = 0; raw < ADC_CODES; ++raw) {
+            sum += float_percent((uint16_t)(raw ^ (uint16_t)round), calibrations[0][0], calibrations[0][1]);
+        }
+    }
+    uint64_t float_ns = test_now_ns() - start;
+    test_sink = sum;
+
+    sum = 0;
+    start = test_now_ns();
+    for (int round = 0; round < BENCH_ROUNDS; ++round) {
+        for (uint16_t raw = 0; raw < ADC_CODES; ++raw) {
+            sum += sensor_permille_to_percent(sensor_convert_permille(&conv, (uint16_t)(raw ^ (uint16_t)round)));
+        }
+    }
+    uint64_t fixed_ns = test_now_ns() - start;
+    test_sink = sum;
+
+    double samples = (double)BENCH_ROUNDS * ADC_CODES;
+    printf("float:       %.2f ns/amostra\n", (double)float_ns / samples);
+    printf("ponto fixo:  %.2f ns/amostra\n", (double)fixed_ns / samples);
+    printf("(no host há FPU; no RP2040 o float é emulado em software e a diferença é maior)\n");
+}
+
+int main(void) {
+    test_equivalence_all_codes();
+    bench_conversion();
+    return TEST_RESULT();
+}
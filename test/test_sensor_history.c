@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include "test_common.h"
+#include "sensor_history.h"
+
+// Confere os resumos de sensor_history contra uma varredura direta das leituras
+// cobertas por cada janela (baldes completos + leituras ainda em formação).
+
+#define RATE_HZ       20 // SENSOR_OUTPUT_RATE_HZ
+#define TOTAL_SAMPLES (RATE_HZ * 3600 * 2 + 37) // 2 h e um segundo incompleto
+
+static const uint32_t bucket_seconds[HISTORY_SPAN_COUNT] = { 1, 10, 60 };
+
+// Leituras cobertas pela janela `span`, pelo mesmo critério do resumo
+static uint32_t covered_samples(const sensor_history_t *h, history_span_t span) {
+    uint32_t n = (uint32_t)h->windows[span].filled * bucket_seconds[span] * RATE_HZ + h->second.count;
+    for (uint8_t s = 1; s <= (uint8_t)span; ++s) {
+        n += (uint32_t)h->windows[s - 1].acc.count * bucket_seconds[s - 1] * RATE_HZ;
+    }
+    return n;
+}
+
+static void check_summary(const sensor_history_t *h, history_span_t span, const uint16_t *data, uint32_t n) {
+    history_summary_t summary;
+    CHECK(sensor_history_summary(h, span, &summary));
+    uint32_t len = covered_samples(h, span);
+    CHECK(len > 0 && len <= n);
+
+    uint16_t lo = UINT16_MAX, hi = 0;
+    uint64_t sum = 0;
+    for (uint32_t i = n - len; i < n; ++i) {
+        lo = data[i] < lo ? data[i] : lo;
+        hi = data[i] > hi ? data[i] : hi;
+        sum += data[i];
+    }
+    uint16_t mean = (uint16_t)(sum / len);
+
+    if (summary.min != lo || summary.max != hi || summary.mean + 2 < mean || summary.mean > mean + 2) {
+        fprintf(stderr, "janela %d após %u leituras: min %u/%u max %u/%u média %u/%u\n",
+                span, n, summary.min, lo, summary.max, hi, summary.mean, mean);
+        test_failures++;
+    }
+    // O máximo nunca fica abaixo da leitura atual
+    CHECK(summary.max >= data[n - 1]);
+    CHECK(summary.p50 >= summary.min && summary.p50 <= summary.max);
+    CHECK(summary.p90 >= summary.p50);
+}
+
+int main(void) {
+    static sensor_history_t history;
+    static uint16_t data[TOTAL_SAMPLES];
+    sensor_history_init(&history, RATE_HZ);
+
+    history_summary_t summary;
+    CHECK(!sensor_history_summary(&history, HISTORY_SPAN_1H, &summary));
+
+    srand(7);
+    for (uint32_t n = 0; n < TOTAL_SAMPLES; ++n) {
+        // Onda lenta com ruído e picos isolados, que precisam aparecer no máximo na hora
+        uint16_t value = (uint16_t)((n / 37) % 800 + rand() % 50);
+        if (rand() % 5000 == 0) value = 1000;
+        data[n] = value;
+        sensor_history_push(&history, value);
+
+        if (n == 0) {
+            // Desde a primeira leitura o resumo da hora já existe
+            CHECK(sensor_history_summary(&history, HISTORY_SPAN_1H, &summary));
+            CHECK_EQ_INT(summary.max, value);
+        }
+        check_summary(&history, HISTORY_SPAN_1MIN, data, n + 1);
+        if (n % 7 == 0) {
+            check_summary(&history, HISTORY_SPAN_10MIN, data, n + 1);
+            check_summary(&history, HISTORY_SPAN_1H, data, n + 1);
+        }
+    }
+    printf("sensor_history_t: %zu bytes\n", sizeof(sensor_history_t));
+    return TEST_RESULT();
+}
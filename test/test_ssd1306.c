@@ -0,0 +1,403 @@
+#include <string.h>
+#include "test_common.h"
+#include "ssd1306.h"
+#include "ssd1306_hal.h"
+
+// Teste do driver SSD1306 contra um controlador emulado. As duas saídas do driver
+// (ssd1306_hal_i2c_write, bloqueante, e i2c_dma_write, fluxo IC_DATA_CMD) são
+// substituídas por funções que interpretam as transações como o controlador:
+// byte de controle, comandos com argumentos, janela de colunas/páginas e escrita
+// na GDDRAM no modo de endereçamento vertical. Depois de cada envio, a GDDRAM
+// emulada deve ser igual ao quadro do driver, e os bytes contabilizados devem
+// bater com os bytes que passaram no barramento.
+
+#define PANEL_ADDRESS 0x3C
+#define PANEL_COLS    128
+#define PANEL_PAGES   8
+
+// --- Controlador emulado ---
+
+typedef struct {
+    uint8_t gram[PANEL_COLS * PANEL_PAGES]; // Mesmo arranjo do ram_buffer: x * 8 + página
+    uint8_t mem_mode;                       // 0 = horizontal, 1 = vertical, 2 = página
+    uint8_t x0, x1, p0, p1;                 // Janela de endereçamento
+    uint8_t col, page;                      // Ponteiro de escrita
+    bool display_on;
+    uint8_t charge_pump;
+    uint8_t opcode;                         // Comando aguardando argumentos
+    uint8_t args[2];
+    uint8_t args_needed, args_seen;
+    uint32_t transactions;
+    uint32_t bus_bytes;                     // Endereço + bytes de cada transação
+    uint32_t protocol_errors;
+} panel_t;
+
+static panel_t panel;
+
+static void panel_reset(void) {
+    memset(&panel, 0, sizeof(panel));
+    memset(panel.gram, 0xA5, sizeof(panel.gram)); // RAM indefinida após o reset
+    panel.mem_mode = 2;
+    panel.x1 = PANEL_COLS - 1;
+    panel.p1 = PANEL_PAGES - 1;
+}
+
+static uint8_t panel_arg_count(uint8_t opcode) {
+    switch (opcode) {
+    case SET_COL_ADDR:
+    case SET_PAGE_ADDR:
+        return 2;
+    case SET_MEM_ADDR:
+    case SET_CONTRAST:
+    case SET_MUX_RATIO:
+    case SET_DISP_OFFSET:
+    case SET_COM_PIN_CFG:
+    case SET_DISP_CLK_DIV:
+    case SET_PRECHARGE:
+    case SET_VCOM_DESEL:
+    case SET_CHARGE_PUMP:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void panel_execute(void) {
+    switch (panel.opcode) {
+    case SET_MEM_ADDR:
+        panel.mem_mode = panel.args[0] & 0x03;
+        break;
+    case SET_COL_ADDR:
+        panel.x0 = panel.col = panel.args[0];
+        panel.x1 = panel.args[1];
+        break;
+    case SET_PAGE_ADDR:
+        panel.p0 = panel.page = panel.args[0];
+        panel.p1 = panel.args[1];
+        break;
+    case SET_CHARGE_PUMP:
+        panel.charge_pump = panel.args[0];
+        break;
+    case SET_DISP | 0x00:
+        panel.display_on = false;
+        break;
+    case SET_DISP | 0x01:
+        panel.display_on = true;
+        break;
+    default:
+        break;
+    }
+}
+
+static void panel_command(uint8_t byte) {
+    if (panel.args_needed > panel.args_seen) {
+        panel.args[panel.args_seen++] = byte;
+    } else {
+        panel.opcode = byte;
+        panel.args_needed = panel_arg_count(byte);
+        panel.args_seen = 0;
+    }
+    if (panel.args_seen == panel.args_needed) {
+        panel_execute();
+        panel.args_needed = panel.args_seen = 0;
+    }
+}
+
+// Escrita na GDDRAM: o driver só usa o modo vertical (página avança primeiro)
+static void panel_data(uint8_t byte) {
+    if (panel.mem_mode != 1 || panel.col >= PANEL_COLS || panel.page >= PANEL_PAGES) {
+        panel.protocol_errors++;
+        return;
+    }
+    panel.gram[panel.col * PANEL_PAGES + panel.page] = byte;
+    if (++panel.page > panel.p1) {
+        panel.page = panel.p0;
+        if (++panel.col > panel.x1) {
+            panel.col = panel.x0;
+        }
+    }
+}
+
+// Uma transação (START, endereço, bytes, STOP). Com Co = 1 cada byte vem precedido
+// do seu byte de controle; com Co = 0 o resto da transação tem o mesmo tipo.
+static void panel_transaction(uint8_t addr, const uint8_t *bytes, size_t len) {
+    panel.transactions++;
+    panel.bus_bytes += 1 + (uint32_t)len;
+    if (addr != PANEL_ADDRESS || len < 2) {
+        panel.protocol_errors++;
+        return;
+    }
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = bytes[i++];
+        bool single = (control & 0x80) != 0;
+        bool data = (control & 0x40) != 0;
+        if ((control & 0x3F) != 0) {
+            panel.protocol_errors++;
+            return;
+        }
+        size_t end = single ? (i + 1 < len ? i + 1 : len) : len;
+        for (; i < end; ++i) {
+            if (data) {
+                panel_data(bytes[i]);
+            } else {
+                panel_command(bytes[i]);
+            }
+        }
+    }
+}
+
+// --- Substitutos do hardware ---
+
+static uint32_t fake_clock_us = 0;
+
+uint32_t ssd1306_hal_time_us(void) {
+    fake_clock_us += 7;
+    return fake_clock_us;
+}
+
+int ssd1306_hal_i2c_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    CHECK(!nostop);
+    panel_transaction(addr, src, len);
+    return (int)len;
+}
+
+// i2c_dma_write: valida o fluxo IC_DATA_CMD e o entrega ao controlador, transação
+// por transação. Com `dma_deferred`, a transmissão fica em andamento até
+// dma_complete(), como no hardware; com `dma_reject`, a escrita é recusada.
+static bool dma_in_flight = false;
+static bool dma_deferred = false;
+static bool dma_reject = false;
+static uint32_t dma_writes = 0;
+static uint32_t dma_callbacks = 0;
+static i2c_dma_callback_t dma_callback;
+static void *dma_ctx;
+
+bool i2c_dma_busy(void) {
+    return dma_in_flight;
+}
+
+static void dma_complete(void) {
+    if (!dma_in_flight) {
+        return;
+    }
+    dma_in_flight = false;
+    if (dma_callback != NULL) {
+        dma_callback(dma_ctx, true);
+    }
+}
+
+bool i2c_dma_write(i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count,
+                   i2c_dma_callback_t callback, void *ctx) {
+    (void)i2c;
+    CHECK(!dma_in_flight); // O driver deve consultar i2c_dma_busy() antes
+    if (dma_reject || dma_in_flight || count == 0) {
+        return false;
+    }
+    CHECK(words[count - 1] & I2C_DMA_STOP); // A última palavra encerra a transação
+
+    uint8_t bytes[SSD1306_FRAME_BYTES + 16];
+    size_t len = 0;
+    for (size_t i = 0; i < count; ++i) {
+        CHECK((words[i] & ~(uint16_t)(0xFF | I2C_DMA_STOP)) == 0);
+        CHECK(len < sizeof(bytes));
+        bytes[len++] = (uint8_t)words[i];
+        if (words[i] & I2C_DMA_STOP) {
+            panel_transaction(addr, bytes, len);
+            len = 0;
+        }
+    }
+
+    dma_writes++;
+    dma_callback = callback;
+    dma_ctx = ctx;
+    dma_in_flight = true;
+    if (!dma_deferred) {
+        dma_complete();
+    }
+    return true;
+}
+
+static void count_callback(void *ctx, bool ok) {
+    (void)ctx;
+    CHECK(ok);
+    dma_callbacks++;
+}
+
+// --- Desenho pseudoaleatório ---
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(uint32_t range) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) % range;
+}
+
+static void random_drawing(ssd1306_t *ssd) {
+    static const char *const words[] = { "NVL. AGUA", "CHUVA", "42%", "ALERTA", "-", "1234" };
+    switch (rng(6)) {
+    case 0:
+        ssd1306_pixel(ssd, (uint8_t)rng(128), (uint8_t)rng(64), rng(2));
+        break;
+    case 1:
+        ssd1306_fill_rect(ssd, (int16_t)rng(140) - 6, (int16_t)rng(70) - 3, (int16_t)rng(40), (int16_t)rng(30), rng(2));
+        break;
+    case 2:
+        ssd1306_line(ssd, (uint8_t)rng(128), (uint8_t)rng(64), (uint8_t)rng(128), (uint8_t)rng(64), rng(2));
+        break;
+    case 3:
+        ssd1306_draw_string(ssd, words[rng(6)], (uint8_t)rng(100), (uint8_t)rng(57));
+        break;
+    case 4:
+        ssd1306_draw_text(ssd, &ssd1306_font_prop, words[rng(6)], (uint8_t)rng(100), (uint8_t)rng(57));
+        break;
+    default:
+        ssd1306_draw_text(ssd, &ssd1306_font_digits16, "42%", (uint8_t)rng(80), (uint8_t)rng(49));
+        break;
+    }
+}
+
+// A GDDRAM emulada deve mostrar exatamente o quadro `frame` (x * 8 + página)
+static void check_panel_shows(const uint8_t *frame) {
+    CHECK(memcmp(panel.gram, frame, sizeof(panel.gram)) == 0);
+}
+
+// --- Casos ---
+
+static void test_config(void) {
+    static ssd1306_framebuffers_t buffers;
+    ssd1306_t ssd;
+    panel_reset();
+    CHECK(ssd1306_init_buffered(&ssd, WIDTH, HEIGHT, false, PANEL_ADDRESS, NULL, &buffers));
+    ssd1306_config(&ssd);
+
+    CHECK_EQ_INT(panel.transactions, 1); // A sequência inteira em uma transação
+    CHECK_EQ_INT(panel.mem_mode, 1);     // Vertical, como ssd1306_send_window espera
+    CHECK(panel.display_on);
+    CHECK_EQ_INT(panel.charge_pump, 0x14);
+    CHECK_EQ_INT(ssd.config_us, 7);      // Uma leitura do relógio falso depois da outra
+    CHECK_EQ_INT(panel.protocol_errors, 0);
+
+    // Comando avulso (Co = 1)
+    ssd1306_command(&ssd, SET_DISP | 0x00);
+    CHECK(!panel.display_on);
+    // Endereço + controle + 25 bytes da sequência, mais endereço + 0x80 + comando
+    CHECK_EQ_INT(panel.bus_bytes, (1 + 1 + 25) + (1 + 2));
+}
+
+// Envio bloqueante (ssd1306_send_data) com rastreamento pelas escritas
+static void test_blocking_stream(void) {
+    ssd1306_t ssd;
+    panel_reset();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, PANEL_ADDRESS, NULL);
+    ssd1306_config(&ssd);
+    uint32_t frames = 0;
+
+    for (int i = 0; i < 2000; ++i) {
+        random_drawing(&ssd);
+        if (rng(4) == 0) {
+            uint32_t before = panel.bus_bytes;
+            ssd1306_send_data(&ssd);
+            CHECK_EQ_INT(ssd.bytes_sent_last, panel.bus_bytes - before);
+            check_panel_shows(ssd.ram_buffer + 1);
+            frames++;
+        }
+    }
+    CHECK_EQ_INT(panel.protocol_errors, 0);
+    CHECK(ssd.frames_sent > 0 && ssd.frames_sent <= frames);
+    free(ssd.ram_buffer - 3);
+    free(ssd.tx_buffer);
+    free(ssd.tx_words);
+}
+
+// Fluxo DMA no modo de dois buffers: apresentação por comparação e envio assíncrono
+static void test_dma_stream(void) {
+    static ssd1306_framebuffers_t buffers;
+    ssd1306_t ssd;
+    panel_reset();
+    ssd1306_init_buffered(&ssd, WIDTH, HEIGHT, false, PANEL_ADDRESS, NULL, &buffers);
+    ssd1306_config(&ssd);
+    dma_writes = dma_callbacks = 0;
+
+    // Primeiro envio: tela inteira, pois a RAM do controlador é indefinida
+    CHECK(ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK_EQ_INT(ssd.bytes_sent_last, SSD1306_WINDOW_OVERHEAD_BYTES + 1 + SSD1306_FRAME_BYTES);
+    check_panel_shows(ssd.front_buffer);
+
+    for (int frame = 0; frame < 500; ++frame) {
+        // Como display.c: limpa e redesenha o quadro inteiro
+        ssd1306_fill(&ssd, false);
+        int shapes = 1 + (int)rng(6);
+        for (int s = 0; s < shapes; ++s) {
+            random_drawing(&ssd);
+        }
+        uint32_t changed = ssd1306_present(&ssd);
+        CHECK(memcmp(ssd.front_buffer, ssd.ram_buffer + 1, SSD1306_FRAME_BYTES) == 0);
+
+        uint32_t before = panel.bus_bytes;
+        uint32_t writes = dma_writes;
+        bool started = ssd1306_send_data_async(&ssd, count_callback, NULL);
+        CHECK_EQ_INT(started, changed != 0);        // Quadro igual não gera envio
+        CHECK_EQ_INT(dma_writes - writes, started);
+        if (started) {
+            CHECK_EQ_INT(ssd.bytes_sent_last, panel.bus_bytes - before);
+        }
+        check_panel_shows(ssd.front_buffer);
+    }
+
+    // Mesmo quadro apresentado de novo: nada muda, nada é enviado
+    CHECK_EQ_INT(ssd1306_present(&ssd), 0);
+    CHECK(!ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK_EQ_INT(dma_callbacks, dma_writes);
+    CHECK_EQ_INT(panel.protocol_errors, 0);
+}
+
+// Envio em andamento e escrita recusada: nenhuma alteração se perde
+static void test_busy_and_reject(void) {
+    static ssd1306_framebuffers_t buffers;
+    ssd1306_t ssd;
+    panel_reset();
+    ssd1306_init_buffered(&ssd, WIDTH, HEIGHT, false, PANEL_ADDRESS, NULL, &buffers);
+    ssd1306_config(&ssd);
+    dma_writes = dma_callbacks = 0;
+
+    dma_deferred = true;
+    CHECK(ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK(i2c_dma_busy());
+
+    // Quadro desenhado durante o envio: a tentativa é recusada sem consumir as regiões sujas
+    ssd1306_draw_string(&ssd, "CHEIA", 10, 20);
+    CHECK(ssd1306_present(&ssd) > 0);
+    CHECK(!ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK_EQ_INT(dma_writes, 1);
+
+    dma_complete();
+    CHECK_EQ_INT(dma_callbacks, 1);
+    CHECK(ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK(ssd.bytes_sent_last < SSD1306_WINDOW_OVERHEAD_BYTES + 1 + SSD1306_FRAME_BYTES);
+    dma_complete();
+    dma_deferred = false;
+    check_panel_shows(ssd.front_buffer);
+
+    // Escrita recusada pelo DMA: o próximo envio é completo
+    ssd1306_pixel(&ssd, 5, 5, true);
+    ssd1306_present(&ssd);
+    dma_reject = true;
+    CHECK(!ssd1306_send_data_async(&ssd, count_callback, NULL));
+    dma_reject = false;
+    memset(panel.gram, 0x5A, sizeof(panel.gram)); // Ex.: painel reiniciado
+    CHECK(ssd1306_send_data_async(&ssd, count_callback, NULL));
+    CHECK_EQ_INT(ssd.bytes_sent_last, SSD1306_WINDOW_OVERHEAD_BYTES + 1 + SSD1306_FRAME_BYTES);
+    check_panel_shows(ssd.front_buffer);
+    CHECK_EQ_INT(dma_callbacks, dma_writes);
+    CHECK_EQ_INT(panel.protocol_errors, 0);
+}
+
+int main(void) {
+    test_config();
+    test_blocking_stream();
+    test_dma_stream();
+    test_busy_and_reject();
+    return TEST_RESULT();
+}
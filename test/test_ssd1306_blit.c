@@ -0,0 +1,220 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test_common.h"
+#include "ssd1306.h"
+#include "ssd1306_hal.h"
+
+// Blitter do SSD1306 contra referências pixel a pixel (ssd1306_pixel), como as
+// primitivas eram antes: para operações aleatórias, o quadro e as regiões sujas
+// devem ser idênticos. Depois, o benchmark compara o tempo das duas versões.
+
+// O barramento não interessa aqui: os envios só limpam o rastreamento das regiões
+int ssd1306_hal_i2c_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)src; (void)nostop;
+    return (int)len;
+}
+
+uint32_t ssd1306_hal_time_us(void) {
+    return 0;
+}
+
+bool i2c_dma_busy(void) {
+    return false;
+}
+
+bool i2c_dma_write(i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count,
+                   i2c_dma_callback_t callback, void *ctx) {
+    (void)i2c; (void)addr; (void)words; (void)count; (void)callback; (void)ctx;
+    return true;
+}
+
+// --- Referências pixel a pixel ---
+
+static void ref_fill_rect(ssd1306_t *ssd, int x, int y, int w, int h, bool value) {
+    for (int cx = x; cx < x + w; ++cx) {
+        for (int cy = y; cy < y + h; ++cy) {
+            if (cx >= 0 && cy >= 0 && cx < 256 && cy < 256) {
+                ssd1306_pixel(ssd, (uint8_t)cx, (uint8_t)cy, value);
+            }
+        }
+    }
+}
+
+static void ref_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+    for (int x = left; x < left + width; ++x) {
+        ssd1306_pixel(ssd, (uint8_t)x, top, value);
+        ssd1306_pixel(ssd, (uint8_t)x, (uint8_t)(top + height - 1), value);
+    }
+    for (int y = top; y < top + height; ++y) {
+        ssd1306_pixel(ssd, left, (uint8_t)y, value);
+        ssd1306_pixel(ssd, (uint8_t)(left + width - 1), (uint8_t)y, value);
+    }
+    if (fill) {
+        ref_fill_rect(ssd, left + 1, top + 1, width - 2, height - 2, value);
+    }
+}
+
+// Bitmap opaco em formato de página: cada bit vira um pixel, ligado ou apagado
+static void ref_blit_pages(ssd1306_t *ssd, const uint8_t *data, uint8_t width, uint8_t stride, uint8_t pages,
+                           uint8_t x, uint8_t y) {
+    for (int p = 0; p < pages; ++p) {
+        for (int i = 0; i < width; ++i) {
+            uint8_t bits = data[p * stride + i];
+            for (int j = 0; j < 8; ++j) {
+                int cx = x + i, cy = y + 8 * p + j;
+                if (cx < 256 && cy < 256) {
+                    ssd1306_pixel(ssd, (uint8_t)cx, (uint8_t)cy, (bits >> j) & 1);
+                }
+            }
+        }
+    }
+}
+
+static void ref_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    uint8_t g = (c >= ' ' && c <= '~') ? (uint8_t)(c - ' ') : 0;
+    ref_blit_pages(ssd, &ssd1306_font_8x8.glyphs[g * 8], 8, 8, 1, x, y);
+}
+
+// Glifo g da fonte de dígitos de 16x16 (2 páginas de 16 colunas)
+static const uint8_t *digit_glyph(uint8_t g) {
+    const ssd1306_font_t *f = &ssd1306_font_digits16;
+    return &f->glyphs[(size_t)g * f->pages * f->stride];
+}
+
+static uint32_t rng_state = 2024;
+
+static uint32_t rng(uint32_t range) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) % range;
+}
+
+static bool same_state(const ssd1306_t *a, const ssd1306_t *b) {
+    return memcmp(a->ram_buffer, b->ram_buffer, a->bufsize) == 0 &&
+           memcmp(a->dirty_x0, b->dirty_x0, sizeof(a->dirty_x0)) == 0 &&
+           memcmp(a->dirty_x1, b->dirty_x1, sizeof(a->dirty_x1)) == 0;
+}
+
+// Mesma operação aleatória no blitter (fast) e na referência (ref)
+static void random_operation(ssd1306_t *fast, ssd1306_t *ref) {
+    bool value = rng(2);
+    switch (rng(6)) {
+    case 0: {
+        char c = (char)(' ' + rng(96)); // Inclui 0x7F, fora da fonte
+        uint8_t x = (uint8_t)rng(140), y = (uint8_t)rng(70);
+        ssd1306_draw_char(fast, c, x, y);
+        ref_draw_char(ref, c, x, y);
+        break;
+    }
+    case 1: {
+        uint8_t top = (uint8_t)rng(64), left = (uint8_t)rng(128);
+        uint8_t w = (uint8_t)(1 + rng(40)), h = (uint8_t)(1 + rng(30));
+        if (left + w > 128 || top + h > 64) return;
+        bool fill = rng(2);
+        ssd1306_rect(fast, top, left, w, h, value, fill);
+        ref_rect(ref, top, left, w, h, value, fill);
+        break;
+    }
+    case 2: {
+        uint8_t x0 = (uint8_t)rng(128), x1 = (uint8_t)rng(128), y = (uint8_t)rng(64);
+        ssd1306_hline(fast, x0, x1, y, value);
+        ref_fill_rect(ref, x0 < x1 ? x0 : x1, y, abs(x1 - x0) + 1, 1, value);
+        break;
+    }
+    case 3: {
+        uint8_t y0 = (uint8_t)rng(64), y1 = (uint8_t)rng(64), x = (uint8_t)rng(128);
+        ssd1306_vline(fast, x, y0, y1, value);
+        ref_fill_rect(ref, x, y0 < y1 ? y0 : y1, 1, abs(y1 - y0) + 1, value);
+        break;
+    }
+    case 4: {
+        int16_t x = (int16_t)rng(150) - 10, y = (int16_t)rng(80) - 8;
+        int16_t w = (int16_t)rng(50), h = (int16_t)rng(40);
+        ssd1306_fill_rect(fast, x, y, w, h, value);
+        ref_fill_rect(ref, x, y, w, h, value);
+        break;
+    }
+    default: {
+        uint8_t g = (uint8_t)rng(26), x = (uint8_t)rng(130), y = (uint8_t)rng(64);
+        ssd1306_blit_pages(fast, digit_glyph(g), 16, 16, 2, x, y);
+        ref_blit_pages(ref, digit_glyph(g), 16, 16, 2, x, y);
+        break;
+    }
+    }
+}
+
+static void test_equivalence(ssd1306_t *fast, ssd1306_t *ref) {
+    for (int i = 0; i < 50000; ++i) {
+        random_operation(fast, ref);
+        if (rng(200) == 0) {
+            bool value = rng(2);
+            ssd1306_fill(fast, value);
+            ref_fill_rect(ref, 0, 0, 128, 64, value);
+        }
+        if (!same_state(fast, ref)) {
+            fprintf(stderr, "divergência na operação %d\n", i);
+            test_failures++;
+            return;
+        }
+        // Limpa as regiões sujas de vez em quando para que continuem significativas
+        if (rng(8) == 0) {
+            ssd1306_send_data(fast);
+            ssd1306_send_data(ref);
+        }
+    }
+}
+
+// --- Benchmark ---
+
+typedef void (*bench_fn_t)(ssd1306_t *ssd, int i);
+
+static void bench_fill_fast(ssd1306_t *ssd, int i) { ssd1306_fill(ssd, i & 1); }
+static void bench_fill_ref(ssd1306_t *ssd, int i) { ref_fill_rect(ssd, 0, 0, 128, 64, i & 1); }
+static void bench_char_fast(ssd1306_t *ssd, int i) {
+    ssd1306_draw_char(ssd, (char)('A' + i % 26), (uint8_t)((i * 8) % 120), (uint8_t)((i * 3) % 56));
+}
+static void bench_char_ref(ssd1306_t *ssd, int i) {
+    ref_draw_char(ssd, (char)('A' + i % 26), (uint8_t)((i * 8) % 120), (uint8_t)((i * 3) % 56));
+}
+static void bench_rect_fast(ssd1306_t *ssd, int i) { ssd1306_rect(ssd, 5, 5, 100, 40, i & 1, true); }
+static void bench_rect_ref(ssd1306_t *ssd, int i) { ref_rect(ssd, 5, 5, 100, 40, i & 1, true); }
+static void bench_digit_fast(ssd1306_t *ssd, int i) {
+    ssd1306_blit_pages(ssd, digit_glyph((uint8_t)(i % 26)), 16, 16, 2, (uint8_t)((i * 16) % 112), 3);
+}
+static void bench_digit_ref(ssd1306_t *ssd, int i) {
+    ref_blit_pages(ssd, digit_glyph((uint8_t)(i % 26)), 16, 16, 2, (uint8_t)((i * 16) % 112), 3);
+}
+
+// Melhor de 5 rodadas, em ns por chamada
+static double bench_ns(bench_fn_t fn, ssd1306_t *ssd, int calls) {
+    double best = 0;
+    for (int run = 0; run < 5; ++run) {
+        uint64_t start = test_now_ns();
+        for (int i = 0; i < calls; ++i) {
+            fn(ssd, i);
+        }
+        double ns = (double)(test_now_ns() - start) / calls;
+        if (run == 0 || ns < best) best = ns;
+    }
+    test_sink = ssd->ram_buffer[1];
+    return best;
+}
+
+static void bench_pair(const char *name, bench_fn_t ref_fn, bench_fn_t fast_fn, ssd1306_t *ssd, int calls) {
+    double ref_ns = bench_ns(ref_fn, ssd, calls);
+    double fast_ns = bench_ns(fast_fn, ssd, calls);
+    printf("%-22s pixel a pixel %9.1f ns   blitter %8.1f ns   (x%.1f)\n",
+           name, ref_ns, fast_ns, ref_ns / fast_ns);
+}
+
+int main(void) {
+    ssd1306_t fast, ref;
+    ssd1306_init(&fast, WIDTH, HEIGHT, false, 0x3C, NULL);
+    ssd1306_init(&ref, WIDTH, HEIGHT, false, 0x3C, NULL);
+    test_equivalence(&fast, &ref);
+
+    bench_pair("fill 128x64", bench_fill_ref, bench_fill_fast, &fast, 2000);
+    bench_pair("char 8x8", bench_char_ref, bench_char_fast, &fast, 40000);
+    bench_pair("rect 100x40 cheio", bench_rect_ref, bench_rect_fast, &fast, 10000);
+    bench_pair("digito 16x16 (y=3)", bench_digit_ref, bench_digit_fast, &fast, 20000);
+    return TEST_RESULT();
+}
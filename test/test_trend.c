@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test_common.h"
+#include "trend.h"
+
+// Reproduz séries gravadas (test/traces/*.csv) por trend_push(), comparando a
+// inclinação incremental com um ajuste de mínimos quadrados refeito do zero a
+// cada leitura, e confere quando o alerta de subida rápida seria disparado.
+
+#define TRACE_RATE_HZ     20   // SENSOR_OUTPUT_RATE_HZ
+#define TRACE_WINDOW      100  // TREND_WINDOW_SAMPLES
+#define RAPID_RISE_LIMIT  600  // TREND_RAPID_RISE_PERMILLE_PER_MIN
+#define TRACE_MAX_SAMPLES 2048
+
+typedef struct {
+    const char *file;
+    int32_t min_slope;   // Faixa esperada da inclinação (permilagem/min) com a janela cheia
+    int32_t max_slope;
+    int first_alert_min; // Primeira leitura em que o alerta pode disparar (-1 = nunca)
+    int first_alert_max;
+} trace_case_t;
+
+static const trace_case_t cases[] = {
+    { "steady.csv",      -150,  150,  -1,  -1 },
+    { "slow_rise.csv",    250,  470,  -1,  -1 },
+    // Subida começa na leitura 200; a janela de 5 s precisa de parte dela para passar de 600/min
+    { "flash_flood.csv", -150, 1350, 200, 300 },
+    { "recession.csv",  -1100, -850,  -1,  -1 },
+};
+
+static int load_trace(const char *file, int16_t *out, int max) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", FLOOD_TRACE_DIR, file);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "não abriu %s\n", path);
+        return -1;
+    }
+    char line[256];
+    int n = 0;
+    while (n < max && fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        out[n++] = (int16_t)atoi(line);
+    }
+    fclose(f);
+    return n;
+}
+
+// Referência: mínimos quadrados em double sobre as últimas `window` leituras
+static double reference_slope_per_minute(const int16_t *y, int end, int window) {
+    int start = end - window + 1;
+    if (start < 0) start = 0;
+    int n = end - start + 1;
+    if (n < 2) return 0.0;
+    double mean_i = (n - 1) / 2.0, mean_y = 0.0;
+    for (int k = 0; k < n; ++k) mean_y += y[start + k];
+    mean_y /= n;
+    double num = 0.0, den = 0.0;
+    for (int k = 0; k < n; ++k) {
+        num += (k - mean_i) * (y[start + k] - mean_y);
+        den += (k - mean_i) * (k - mean_i);
+    }
+    return num / den * TRACE_RATE_HZ * 60.0;
+}
+
+static void replay(const trace_case_t *tc) {
+    static int16_t samples[TRACE_MAX_SAMPLES];
+    int n = load_trace(tc->file, samples, TRACE_MAX_SAMPLES);
+    CHECK(n > TRACE_WINDOW);
+    if (n <= TRACE_WINDOW) {
+        return;
+    }
+
+    static trend_t trend;
+    trend_init(&trend, TRACE_WINDOW);
+    int first_alert = -1;
+    int32_t min_slope = INT32_MAX, max_slope = INT32_MIN;
+    for (int i = 0; i < n; ++i) {
+        trend_push(&trend, samples[i]);
+        int32_t slope = trend_slope_per_minute(&trend, TRACE_RATE_HZ);
+
+        // Divisão inteira truncada: no máximo 1 unidade longe da referência
+        double reference = reference_slope_per_minute(samples, i, TRACE_WINDOW);
+        double error = slope - reference;
+        if (error > 1.0 || error < -1.0) {
+            fprintf(stderr, "%s[%d]: inclinação %d, referência %.2f\n", tc->file, i, slope, reference);
+            test_failures++;
+        }
+
+        if (!trend_is_full(&trend)) {
+            continue;
+        }
+        if (slope < min_slope) min_slope = slope;
+        if (slope > max_slope) max_slope = slope;
+        if (first_alert < 0 && slope >= RAPID_RISE_LIMIT) {
+            first_alert = i;
+        }
+    }
+
+    printf("%-16s %4d leituras, inclinação %5d..%5d /min, alerta na leitura %d\n",
+           tc->file, n, min_slope, max_slope, first_alert);
+    CHECK(min_slope >= tc->min_slope);
+    CHECK(max_slope <= tc->max_slope);
+    if (tc->first_alert_min < 0) {
+        CHECK_EQ_INT(first_alert, -1);
+    } else {
+        CHECK(first_alert >= tc->first_alert_min);
+        CHECK(first_alert <= tc->first_alert_max);
+    }
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        replay(&cases[i]);
+    }
+    return TEST_RESULT();
+}